@@ -985,6 +985,27 @@ w_rc_t    sthread_t::writev(int fd, const iovec_t *iov, size_t iovcnt)
 }
 
 
+w_rc_t    sthread_t::pwritev(int fd, const iovec_t *iov, size_t iovcnt,
+        fileoff_t pos)
+{
+    fd -= fd_base;
+    if (fd < 0 || fd >= (int)open_max || !_disks[fd])
+        return RC(stBADFD);
+
+    int    done = 0;
+    int    total = 0;
+    w_rc_t    e;
+
+    total = sdisk_t::vsize(iov, iovcnt);
+
+    e = _disks[fd]->pwritev(iov, iovcnt, pos, done);
+    if (!e.is_error() && done != total)
+        e = RC(stSHORTIO);
+
+    return e;
+}
+
+
 w_rc_t    sthread_t::pread(int fd, void *buf, int n, fileoff_t pos)
 {
     fd -= fd_base;
@@ -1035,6 +1056,24 @@ w_rc_t    sthread_t::pwrite(int fd, const void *buf, int n, fileoff_t pos)
 }
 
 
+w_rc_t    sthread_t::fallocate(int fd, fileoff_t off, fileoff_t len)
+{
+    fd -= fd_base;
+    if (fd < 0 || fd >= (int)open_max || !_disks[fd])
+        return RC(stBADFD);
+
+    return _disks[fd]->fallocate(off, len);
+}
+
+w_rc_t    sthread_t::fadvise(int fd, fileoff_t off, fileoff_t len, int advice)
+{
+    fd -= fd_base;
+    if (fd < 0 || fd >= (int)open_max || !_disks[fd])
+        return RC(stBADFD);
+
+    return _disks[fd]->fadvise(off, len, advice);
+}
+
 w_rc_t    sthread_t::fsync(int fd)
 {
     fd -= fd_base;
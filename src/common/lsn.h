@@ -245,9 +245,8 @@ public:
     enum { PARTITION_BITS=16 };
     enum { PARTITION_SHIFT=(64-PARTITION_BITS) };
 
-    static uint64_t mask() {
-        static uint64_t const ONE = 1;
-        return (ONE << PARTITION_SHIFT)-1;
+    static constexpr uint64_t mask() {
+        return (((uint64_t) 1) << PARTITION_SHIFT) - 1;
     }
 
     lsn_t() : _data(0) { }
@@ -256,8 +255,10 @@ public:
     lsn_t(uint32_t f, sm_diskaddr_t r) :
                 _data(from_file(f) | from_rba(r)) { }
 
-    // copy operator
-    lsn_t(const lsn_t & other) : _data(other._data) { }
+    // default these so lsn_t stays trivially copyable: it is just a
+    // packed 64-bit word and should be passed and stored as one
+    lsn_t(const lsn_t & other) = default;
+    lsn_t& operator=(const lsn_t & other) = default;
 
     lsndata_t data()         const { return _data; }
     void set (lsndata_t data) {_data = data;}
@@ -322,25 +323,34 @@ public:
 private:
     lsndata_t        _data;
 
-    static uint32_t to_file(uint64_t f) {
+    // constexpr so that field extraction and packing fold to a single
+    // shift/and/or each -- these run once per log record on the scan
+    // and recovery paths
+    static constexpr uint32_t to_file(uint64_t f) {
                 return (uint32_t) (f >> PARTITION_SHIFT); }
 
-    static uint64_t get_file(uint64_t data) {
+    static constexpr uint64_t get_file(uint64_t data) {
                 return data &~ mask(); }
 
-    static uint64_t from_file(uint32_t data) {
+    static constexpr uint64_t from_file(uint32_t data) {
                 return ((uint64_t) data) << PARTITION_SHIFT; }
 
-    static sm_diskaddr_t to_rba(uint64_t r) {
+    static constexpr sm_diskaddr_t to_rba(uint64_t r) {
                 return (sm_diskaddr_t) (r & mask()); }
 
-    static uint64_t get_rba(uint64_t data) {
+    static constexpr uint64_t get_rba(uint64_t data) {
                 return to_rba(data); }
 
-    static uint64_t from_rba(sm_diskaddr_t data) {
+    static constexpr uint64_t from_rba(sm_diskaddr_t data) {
                 return to_rba(data); }
 };
 
+// the packing above assumes the whole lsn fits one 64-bit word with
+// disjoint file/rba fields
+static_assert(sizeof(lsndata_t) == 8, "lsn_t must pack into 64 bits");
+static_assert(lsn_t::PARTITION_BITS + lsn_t::PARTITION_SHIFT == 64,
+        "file and rba fields must partition the 64-bit word");
+
 inline ostream& operator<<(ostream& o, const lsn_t& l)
 {
     return o << l.file() << '.' << l.rba();
@@ -78,7 +78,10 @@ namespace memory_block {
    arrays.
  */
 #ifdef __GNUC__
-#define EMPTY_ARRAY_DIM
+/* Zero-length arrays are a GNU extension; unlike the unsized form they
+   are also accepted in the middle of a struct (block_list embeds a
+   block by value), which newer GCCs enforce. */
+#define EMPTY_ARRAY_DIM 0
 #else
 #define EMPTY_ARRAY_DIM 0
 #endif
@@ -78,6 +78,7 @@ Rome Research Laboratory Contract No. F30602-97-2-0247.
 #define    os_writev(d,v,c) writev(d,v,c)
 #define    os_pread(d,b,c,p)    pread(d,b,c,p)
 #define    os_pwrite(d,b,c,p)    pwrite(d,b,c,p)
+#define    os_pwritev(d,v,c,p)    pwritev(d,v,c,p)
 
 #ifndef os_lseek
 #define    os_lseek(d,o,w)    lseek(d,o,w)
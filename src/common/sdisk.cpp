@@ -177,11 +177,31 @@ w_rc_t    sdisk_t::pwrite(const void *, int , fileoff_t ,
   return RC(fcNOTIMPLEMENTED);
 }
 
+w_rc_t    sdisk_t::pwritev(const iovec_t *, int , fileoff_t ,
+               int &)
+{
+  // make it safe or don't do it at all.
+  return RC(fcNOTIMPLEMENTED);
+}
+
 w_rc_t    sdisk_t::rename(const char*, const char*)
 {
     return RC(fcNOTIMPLEMENTED);
 }
 
+/* pre-allocation is an optional optimization; callers must cope
+   with it being unavailable. */
+w_rc_t    sdisk_t::fallocate(fileoff_t, fileoff_t)
+{
+    return RC(fcNOTIMPLEMENTED);
+}
+
+/* access-pattern hints are purely advisory; ignoring them is correct. */
+w_rc_t    sdisk_t::fadvise(fileoff_t, fileoff_t, int)
+{
+    return RCOK;
+}
+
 
 /* a no-op file-sync if the underlying implementation doesn't support it. */
 w_rc_t    sdisk_t::sync()
@@ -131,6 +131,13 @@ public:
         SEEK_AT_END=2        // from end-of-file
     };
 
+    /* access-pattern hints, mirroring posix_fadvise */
+    enum {
+        ADVISE_SEQUENTIAL=0,    // will be read front to back
+        ADVISE_WILLNEED=1,    // will be read soon
+        ADVISE_DONTNEED=2    // won't be accessed again; drop cached pages
+    };
+
     /* utility functions */
     static    int    vsize(const iovec_t *iov, int iovcnt);
 };
@@ -162,12 +169,16 @@ public:
     virtual    w_rc_t    pread(void *buf, int count, fileoff_t pos, int &done);
     virtual    w_rc_t    pwrite(const void *buf, int count,
                    fileoff_t pos, int &done);
+    virtual    w_rc_t    pwritev(const iovec_t *iov, int ioc,
+                   fileoff_t pos, int &done);
 
     virtual w_rc_t    seek(fileoff_t pos, int origin, fileoff_t &newpos) = 0;
 
     virtual w_rc_t    rename(const char* oldname, const char* newname) = 0;
 
     virtual w_rc_t    truncate(fileoff_t size) = 0;
+    virtual w_rc_t    fallocate(fileoff_t off, fileoff_t len);
+    virtual w_rc_t    fadvise(fileoff_t off, fileoff_t len, int advice);
     virtual w_rc_t    sync();
 
     virtual    w_rc_t    stat(filestat_t &stat);
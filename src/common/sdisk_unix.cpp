@@ -271,6 +271,24 @@ w_rc_t    sdisk_unix_t::writev(const iovec_t *iov, int iovcnt, int &done)
 }
 #endif
 
+#ifdef HAVE_IO_VECTOR
+w_rc_t    sdisk_unix_t::pwritev(const iovec_t *iov, int iovcnt,
+                fileoff_t pos, int &done)
+{
+    if (_fd == FD_NONE)
+        return RC(stBADFD);
+
+    int    n;
+
+    n = ::os_pwritev(_fd, (const struct iovec *)iov, iovcnt, pos);
+    CHECK_ERRNO(n);
+
+    done = n;
+
+    return RCOK;
+}
+#endif
+
 w_rc_t    sdisk_unix_t::pread(void *buf, int count, fileoff_t pos, int &done)
 {
     if (_fd == FD_NONE)
@@ -346,6 +364,55 @@ w_rc_t    sdisk_unix_t::truncate(fileoff_t size)
     return RCOK;
 }
 
+w_rc_t    sdisk_unix_t::fallocate(fileoff_t off, fileoff_t len)
+{
+    if (_fd == FD_NONE)
+        return RC(stBADFD);
+
+#ifdef FALLOC_FL_KEEP_SIZE
+    // KEEP_SIZE so st_size still reflects what was actually written
+    int n = ::fallocate(_fd, FALLOC_FL_KEEP_SIZE, off, len);
+    CHECK_ERRNO(n);
+
+    return RCOK;
+#else
+    return sdisk_t::fallocate(off, len);
+#endif
+}
+
+w_rc_t    sdisk_unix_t::fadvise(fileoff_t off, fileoff_t len, int advice)
+{
+    if (_fd == FD_NONE)
+        return RC(stBADFD);
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    int posix_advice;
+    switch (advice) {
+    case ADVISE_SEQUENTIAL:
+        posix_advice = POSIX_FADV_SEQUENTIAL;
+        break;
+    case ADVISE_WILLNEED:
+        posix_advice = POSIX_FADV_WILLNEED;
+        break;
+    case ADVISE_DONTNEED:
+        posix_advice = POSIX_FADV_DONTNEED;
+        break;
+    default:
+        return RC(fcNOTIMPLEMENTED);
+    }
+
+    /* posix_fadvise returns the error number directly, not via errno */
+    int n = ::posix_fadvise(_fd, off, len, posix_advice);
+    if (n != 0) {
+        W_RETURN_RC_MSG(fcOS, << "Kernel errno code: " << n);
+    }
+
+    return RCOK;
+#else
+    return sdisk_t::fadvise(off, len, advice);
+#endif
+}
+
 w_rc_t    sdisk_unix_t::sync()
 {
     if (_fd == FD_NONE)
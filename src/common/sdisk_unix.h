@@ -78,6 +78,7 @@ public:
 
     w_rc_t    pread(void *buf, int count, fileoff_t pos, int &done);
     w_rc_t    pwrite(const void *buf, int count, fileoff_t pos, int &done);
+    w_rc_t    pwritev(const iovec_t *iov, int iovcnt, fileoff_t pos, int &done);
 
     w_rc_t    seek(fileoff_t pos, int origin, fileoff_t &newpos);
 
@@ -85,6 +86,10 @@ public:
 
     w_rc_t    truncate(fileoff_t size);
 
+    w_rc_t    fallocate(fileoff_t off, fileoff_t len);
+
+    w_rc_t    fadvise(fileoff_t off, fileoff_t len, int advice);
+
     w_rc_t    sync();
 
     w_rc_t    stat(filestat_t &st);
@@ -198,6 +198,11 @@ public:
     SEEK_AT_CUR = sdisk_base_t::SEEK_AT_CUR,
     SEEK_AT_END = sdisk_base_t::SEEK_AT_END
     };
+    enum {
+    ADVISE_SEQUENTIAL = sdisk_base_t::ADVISE_SEQUENTIAL,
+    ADVISE_WILLNEED = sdisk_base_t::ADVISE_WILLNEED,
+    ADVISE_DONTNEED = sdisk_base_t::ADVISE_DONTNEED
+    };
 /**\endcond skip */
 };
 
@@ -466,6 +471,10 @@ typedef w_pthread_lock_t queue_based_block_lock_t; // blocking impl always ok
 // non-static initialize:
 #define QUEUE_BLOCK_EXT_QNODE_INITIALIZE(x) x._held = NULL
 
+// mcs_lock is used directly (e.g. by the log) even when the
+// queue-based locks below are pthread-based
+#include <mcs_lock.h>
+
 #ifdef USE_PTHREAD_MUTEX
 typedef w_pthread_lock_t queue_based_spin_lock_t; // spin impl preferred
 typedef w_pthread_lock_t queue_based_lock_t; // might want to use spin impl
@@ -474,7 +483,6 @@ typedef w_pthread_lock_t queue_based_lock_t; // might want to use spin impl
 // non-static initialize:
 #define QUEUE_EXT_QNODE_INITIALIZE(x) x._held = NULL;
 #else
-#include <mcs_lock.h>
 typedef mcs_lock queue_based_spin_lock_t; // spin preferred
 typedef mcs_lock queue_based_lock_t;
 #define QUEUE_SPIN_EXT_QNODE_INITIALIZER MCS_EXT_QNODE_INITIALIZER
@@ -719,6 +727,12 @@ public:
                             const iovec_t*                iov,
                             size_t                 iovcnt);
 
+    static w_rc_t        pwritev(
+                            int                 fd,
+                            const iovec_t*                iov,
+                            size_t                 iovcnt,
+                            fileoff_t            pos);
+
     static w_rc_t        pread(int fd, void *buf, int n, fileoff_t pos);
     static w_rc_t        pread_short(int fd, void *buf, int n, fileoff_t pos,
                             int& done);
@@ -735,6 +749,9 @@ public:
                             fileoff_t                offset,
                             int                whence);
     static w_rc_t        fsync(int fd);
+    static w_rc_t        fallocate(int fd, fileoff_t off, fileoff_t len);
+    static w_rc_t        fadvise(int fd, fileoff_t off, fileoff_t len,
+                            int advice);
     static w_rc_t        ftruncate(int fd, fileoff_t sz);
     static w_rc_t        frename(int fd, const char* o, const char* n);
     static w_rc_t        fstat(int fd, filestat_t &sb);
@@ -911,10 +928,8 @@ SPECIALIZE_CS(tatas_lock, int _dummy, (_dummy=0),
 // queue_based_lock_t asserts is_mine() in release()
 SPECIALIZE_CS(w_pthread_lock_t, w_pthread_lock_t::ext_qnode _me, (_me._held=0),
     _mutex->acquire(&_me), _mutex->release(&_me));
-#ifndef USE_PTHREAD_MUTEX
 SPECIALIZE_CS(mcs_lock, mcs_lock::ext_qnode _me, (_me._held=0),
     _mutex->acquire(&_me), _mutex->release(&_me));
-#endif
 
 SPECIALIZE_CS(occ_rwlock::occ_rlock, int _dummy, (_dummy=0),
     _mutex->acquire(), _mutex->release());
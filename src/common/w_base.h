@@ -175,7 +175,8 @@ Rome Research Laboratory Contract No. F30602-97-2-0247.
 
 /// Default assert/debug level is 0.
 #define w_assert0(x)    do {                        \
-    if (!(x)) w_base_t::assert_failed(#x, __FILE__, __LINE__);    \
+    if (__builtin_expect(!(x), 0))                    \
+        w_base_t::assert_failed(#x, __FILE__, __LINE__);    \
 } while(0)
 
 #define w_assert0_msg(x, msg)                                           \
@@ -384,13 +385,15 @@ public:
         const w_base_t&            obj);
 
     /// print a message and abort
+    /// (cold + noreturn: always-on asserts in hot loops then cost one
+    /// predicted-untaken test, with the call laid out off the hot path)
     static void            assert_failed(
         const char*            desc,
         const char*            file,
-        uint32_t             line);
+        uint32_t             line) __attribute__((noreturn, cold));
 
-    /// dump core
-    static    void        abort();
+    /// dump core (noreturn so assert_failed provably never falls through)
+    static    void        abort() __attribute__((noreturn));
 
     /**\brief Comparison Operators 
      * \enum CompareOp
@@ -170,6 +170,12 @@ extern w_debug _w_debug;
             << _strip_filename(file) << " (" << line << ") " a; \
        std::cerr << ss.str() << endl;
 
+// Note on cost: the stringstream in DBGPRINT is only constructed after
+// flag_on() passes, and the leveled DBGOUTn macros below expand to
+// nothing when W_DEBUG_LEVEL is lower -- in a release build the
+// iostream formatting in hot loops does not merely go unprinted, it is
+// not compiled at all. That is why these stay on plain iostreams
+// instead of a compile-time-parsed formatting library.
 #define DBGOUT(a) do { \
     if(_w_debug.flag_on(__func__,_strip_filename(__FILE__))) { \
         DBGPRINT(a, __FILE__, __LINE__); \
@@ -126,6 +126,10 @@ union gc_pointer_raw {
 
     /** Integer representation, which is handy for single-word CAS. */
     uint64_t word;
+
+    bool operator==(const gc_pointer_raw& other) const { return word == other.word; }
+
+    bool operator!=(const gc_pointer_raw& other) const { return word != other.word; }
 };
 
 /**
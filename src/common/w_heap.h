@@ -100,6 +100,11 @@ class Heap
                         /**\brief Recompute to restore heap property */
         void            Heapify();
 
+                        /**\brief Pre-size storage for an anticipated
+                         * element count, so a bulk build does not pass
+                         * through the doubling growth steps */
+        void            Reserve(int numExpected);
+
                         /**\brief Get reference to top of heap (do not remove) */
         T&              First();
 
@@ -110,7 +115,14 @@ class Heap
         const T&        Second() const;
 
                         /**\brief Inform heap that I replaced the top: recompute, but
-                         * more efficient than Heapify() */
+                         * more efficient than Heapify().
+                         * Worst case O(log n), but the sift-down stops at the
+                         * first level where the heap property holds, so when the
+                         * replaced top still belongs at the top (the common case
+                         * for a caller that repeatedly consumes from and updates
+                         * the same hottest element) it costs only the two child
+                         * comparisons -- no special still-on-top fast path is
+                         * needed around it. */
         void            ReplacedFirst();
 
                         /**\brief Inform heap that element \e i must rise in heap
@@ -342,6 +354,15 @@ void Heap<T, Cmp>::AddElement(const T& elem)
 // use this to fill the heap initially.
 // proceed with a call to Heapify() when all elements are added.
 
+template<class T, class Cmp>
+void Heap<T, Cmp>::Reserve(int numExpected)
+{
+    if (numExpected > maxNumElements)  {
+        GrowElements(numExpected);
+    }
+}
+
+
 template<class T, class Cmp>
 void Heap<T, Cmp>::AddElementDontHeapify(const T& elem)
 {
@@ -529,6 +529,14 @@ public:
     T*                curr() const  {
         return _curr;
     }
+
+    /// Return the item the next call to next() will yield, without
+    /// advancing the iterator. Returns NULL at the end of the list.
+    /// Useful for prefetching the successor while working on curr().
+    T*                peek_next() const  {
+        return (_next && _next != &(_list->_tail)) ?
+            _list->base_of(_next) : 0;
+    }
     
 protected: 
     const w_list_t<T, LOCK>*        _list;
@@ -273,6 +273,33 @@ bool bf_hashtable<T>::lookup(PageID key, T& value) const {
     return _table[hash % _size].find(key, value);
 }
 
+template<class T>
+void bf_hashtable<T>::prefetch_bucket(PageID key) const {
+    uint32_t hash = bf_hash(key);
+    __builtin_prefetch(_table + (hash % _size), 0 /* read */);
+}
+
+template<class T>
+bool bf_hashtable<T>::lookup_imprecise(PageID key, T& value) const {
+    // Lock-free probe of the bucket's inline chunk only. Concurrent
+    // inserts/removals can make this miss an entry or return a stale
+    // one, and overflow entries past the inline chunk are never seen;
+    // callers must tolerate both (see the declaration).
+    uint32_t hash = bf_hash(key);
+    bf_hashbucket<T>& bucket = _table[hash % _size];
+    uint32_t count = bucket._used_count;
+    if (count > HASHBUCKET_INITIAL_CHUNK_SIZE) {
+        count = HASHBUCKET_INITIAL_CHUNK_SIZE;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        if (bucket._chunk.keys[i] == key) {
+            value = bucket._chunk.values[i];
+            return true;
+        }
+    }
+    return false;
+}
+
 template<class T>
 bool bf_hashtable<T>::remove(PageID key) {
     uint32_t hash = bf_hash(key);
@@ -33,6 +33,12 @@ typedef pair<bf_idx, bf_idx> bf_idx_pair;
  * latching on it to change its hash function.
  * As the cost of hash collision is relatively cheap, we avoid cuckoo-hashing.
  * (This design might be revisited later, though).
+ * The same argument applies to open addressing with linear probing:
+ * deletes would have to relocate or tombstone entries under the bucket
+ * spinlock. Instead each bucket stores its first four key/value pairs
+ * inline (see bf_hashbucket_chunk), so a probe resolves within the
+ * bucket's own cache lines and only overflow past four entries chases
+ * a pointer -- cache-line-dense where it matters without relocation.
  *
  * Another notable difference is that now this hashtable is totally separated
  * from the bufferpool itself. In other words, it's merely an unoredered_map<pageid, bf_idx>
@@ -57,11 +63,19 @@ public:
      */
     bool      lookup(PageID key, T& value) const;
 
+    /**
+     * Prefetches the bucket a lookup() of this key would touch.
+     * Just a cache hint for callers that know the key early.
+     */
+    void      prefetch_bucket(PageID key) const;
+
     /**
      * Imprecise-but-fast version of lookup().
      * This method doesn't take latch, so it's much faster. However false-positives/negatives
      * are possible. The caller must make sure false-positives/negatives won't cause an issue.
-     * This is so far used from eviction routine, which doesn't have to be precise.
+     * This is so far used from best-effort paths such as the redo read-ahead,
+     * which don't have to be precise. Note that it only sees the bucket's
+     * inline chunk, never the overflow chain.
      */
     bool      lookup_imprecise(PageID key, T& value) const;
 
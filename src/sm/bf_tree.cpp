@@ -15,6 +15,7 @@
 #include <string.h>
 #include "w_findprime.h"
 #include <stdlib.h>
+#include <sys/mman.h>
 
 #include "sm_base.h"
 #include "sm.h"
@@ -226,6 +227,34 @@ bf_idx bf_tree_m::lookup(PageID pid) const
     return idx;
 }
 
+void bf_tree_m::prefetch_lookup(PageID pid) const
+{
+    _hashtable->prefetch_bucket(pid);
+}
+
+void bf_tree_m::prefetch_page(PageID pid) const
+{
+    bf_idx_pair p;
+    if (!_hashtable->lookup_imprecise(pid, p)) {
+        smlevel_0::vol->prefetch_page(pid);
+    }
+}
+
+void bf_tree_m::prefault_frames() const
+{
+#ifdef MADV_POPULATE_WRITE
+    // available since Linux 5.14: populate and dirty the pages now, so
+    // later first-writes into frames take no fault at all
+    (void) ::madvise(_buffer, SM_PAGESIZE * (uint64_t) _block_cnt,
+            MADV_POPULATE_WRITE);
+#else
+    // best effort on older kernels; for anonymous memory this at most
+    // starts the fault-in early
+    (void) ::madvise(_buffer, SM_PAGESIZE * (uint64_t) _block_cnt,
+            MADV_WILLNEED);
+#endif
+}
+
 ///////////////////////////////////   Page fix/unfix BEGIN         ///////////////////////////////////
 // NOTE most of the page fix/unfix functions are in bf_tree_inline.h.
 // These functions are here are because called less frequently.
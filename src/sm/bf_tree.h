@@ -236,6 +236,31 @@ public:
 
     bf_idx lookup(PageID pid) const;
 
+    /**
+     * Issues a prefetch for the hash bucket a lookup of the given pid
+     * would probe, so a caller that knows the pid ahead of time can
+     * overlap the bucket's cache miss with other work. Purely a hint;
+     * no latching, no effect on correctness.
+     */
+    void prefetch_lookup(PageID pid) const;
+
+    /**
+     * If the page does not appear to be resident, hint the volume to
+     * start reading its image (see vol_t::prefetch_page()). Uses the
+     * imprecise latch-free lookup: a stale answer wastes or skips one
+     * hint, nothing more.
+     */
+    void prefetch_page(PageID pid) const;
+
+    /**
+     * Asks the kernel to pre-fault the frame array. The pool is
+     * allocated but never touched up front, so the first write into
+     * each frame otherwise takes a minor page fault; bulk loaders of
+     * many frames (restart REDO) call this once instead of faulting
+     * per frame. Purely a hint; failures are ignored.
+     */
+    void prefault_frames() const;
+
     /**
      * Returns true if the page's _used flag is on
      */
@@ -51,7 +51,7 @@
  * block, such as when you are incrementing for the case of 3) above.
  *
  */
-struct bf_tree_cb_t {
+struct alignas(64) bf_tree_cb_t {
     /**
      * Maximum value of the per-frame refcount (reference counter).  We cap the
      * refcount to avoid contention on the cacheline of the frame's control
@@ -220,4 +220,18 @@ struct bf_tree_cb_t {
     }
 };
 
+// The hand-counted padding above must keep the control block at exactly
+// one cacheline (plus the embedded latch, itself one cacheline, when it
+// is not interleaved). Threads pin/unpin and update adjacent control
+// blocks concurrently -- e.g. parallel REDO workers sweeping the
+// dirty-page table -- so a size drift would reintroduce false sharing
+// silently.
+#ifdef BP_ALTERNATE_CB_LATCH
+static_assert(sizeof(bf_tree_cb_t) == 64,
+        "bf_tree_cb_t must occupy exactly one cacheline");
+#else
+static_assert(sizeof(bf_tree_cb_t) == 64 + sizeof(latch_t),
+        "bf_tree_cb_t must occupy one cacheline plus its latch");
+#endif
+
 #endif // BF_TREE_CB_H
@@ -61,7 +61,6 @@ Rome Research Laboratory Contract No. F30602-97-2-0247.
 
 #include "sm_options.h"
 #include "sm_base.h"
-#include "w_heap.h"
 #include "logarchiver.h"
 #include "w_okvl.h"
 #include "xct.h"
@@ -69,6 +68,7 @@ Rome Research Laboratory Contract No. F30602-97-2-0247.
 #include <vector>
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <algorithm>
 #include <limits>
 
@@ -99,7 +99,10 @@ struct xct_tab_entry_t {
         state(xct_t::xct_active), last_lsn(lsn_t::null), first_lsn(lsn_t::max) {}
 };
 
-typedef map<PageID, buf_tab_entry_t>       buf_tab_t;
+// Hash table rather than a tree: log analysis does one lookup per
+// page-touching log record, and nothing depends on iterating the
+// dirty-page table in pid order.
+typedef unordered_map<PageID, buf_tab_entry_t> buf_tab_t;
 typedef map<tid_t, xct_tab_entry_t>        xct_tab_t;
 
 class chkpt_t {
@@ -107,6 +110,11 @@ class chkpt_t {
 private:
     tid_t highest_tid;
 
+    // Minima over the surviving entries, folded into the pass cleanup()
+    // already makes over both tables; valid once scan_log() returns.
+    lsn_t min_rec_lsn;
+    lsn_t min_xct_lsn;
+
 public: // required for restart for now
     buf_tab_t buf_tab;
     xct_tab_t xct_tab;
@@ -115,13 +123,16 @@ public: // required for restart for now
 public:
     void scan_log();
 
-    void mark_page_dirty(PageID pid, lsn_t page_lsn, lsn_t rec_lsn);
+    buf_tab_entry_t& mark_page_dirty(PageID pid, lsn_t page_lsn, lsn_t rec_lsn);
     void mark_page_clean(PageID pid, lsn_t lsn);
 
-    void mark_xct_active(tid_t tid, lsn_t first_lsn, lsn_t last_lsn);
-    void mark_xct_ended(tid_t tid);
+    // returns the (possibly just-created) entry so callers processing a
+    // log record can check the state and attach locks without probing
+    // the table once per operation
+    xct_tab_entry_t& mark_xct_active(tid_t tid, lsn_t first_lsn, lsn_t last_lsn);
+    xct_tab_entry_t& mark_xct_ended(tid_t tid);
     bool is_xct_active(tid_t tid) const;
-    void delete_xct(tid_t tid);
+    void add_lock(xct_tab_entry_t& xct, okvl_mode mode, uint32_t hash);
     void add_lock(tid_t tid, okvl_mode mode, uint32_t hash);
 
     void add_backup(const char* path);
@@ -136,11 +147,15 @@ public:
 
 private:
     void init();
+    // Kept out of line so the filesystem and stream machinery it pulls
+    // in does not inflate the per-record loop of scan_log, which takes
+    // this path at most once per analysis.
+    bool load_chkpt_file(lsn_t lsn) __attribute__((noinline));
     void serialize();
     void serialize_binary(ofstream& ofs);
     void deserialize_binary(ifstream& ofs);
     void cleanup();
-    void acquire_lock(logrec_t& r);
+    void acquire_lock(xct_tab_entry_t& xct, logrec_t& r);
 };
 
 
@@ -79,8 +79,95 @@ Rome Research Laboratory Contract No. F30602-97-2-0247.
 #include <w_strstream.h>
 #include <sys/stat.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 typedef smlevel_0::fileoff_t fileoff_t;
 
+/**
+ * Bit set in _end while an epoch change (segment wrap, partition switch,
+ * truncation) is in progress. Fast-path reservations check for it and
+ * fall back to the C-array; see log_core::_reserve_buffer_space.
+ */
+const int64_t INSERT_POS_SEAL = int64_t(1) << 62;
+
+/**
+ * Log-buffer copy helper. Records are write-once: nothing reads the
+ * bytes until the flush daemon picks them up, so multi-KB payloads
+ * (page images and the like) are streamed with non-temporal stores to
+ * keep them from evicting hotter lines. Small records take plain
+ * memcpy, which beats the alignment fixups below that threshold.
+ */
+#ifdef __SSE2__
+const size_t NT_COPY_MIN = 4096;
+
+static void nt_copy(char* dst, const char* src, size_t size)
+{
+    // scalar head until dst is 16-byte aligned (streaming stores
+    // require an aligned destination; the source may stay unaligned)
+    size_t head = (16 - (uintptr_t(dst) & 15)) & 15;
+    if (head > 0) {
+        memcpy(dst, src, head);
+        dst += head;
+        src += head;
+        size -= head;
+    }
+
+    size_t chunks = size / 16;
+    for (size_t i = 0; i < chunks; i++) {
+        _mm_stream_si128((__m128i*) dst, _mm_loadu_si128((const __m128i*) src));
+        dst += 16;
+        src += 16;
+    }
+    // order the weakly-ordered streaming stores before the epoch
+    // publication that follows the copy
+    _mm_sfence();
+
+    if (size % 16 != 0) {
+        memcpy(dst, src, size % 16);
+    }
+}
+#endif
+
+// Partial evaluation for the most frequent record sizes: log
+// records are 8-byte aligned and the smallest (commit, abort,
+// small btree ops) are 48-96 bytes. A compile-time length lets the
+// compiler inline a fixed store sequence instead of calling the
+// generic memcpy with its runtime length dispatch. Shared by the
+// insert-side buffer_copy and the fetch path, which copies one record
+// per scan step during recovery.
+static inline void sized_copy(char* dst, const char* src, size_t size)
+{
+    switch (size) {
+    case 48: __builtin_memcpy(dst, src, 48); return;
+    case 56: __builtin_memcpy(dst, src, 56); return;
+    case 64: __builtin_memcpy(dst, src, 64); return;
+    case 72: __builtin_memcpy(dst, src, 72); return;
+    case 80: __builtin_memcpy(dst, src, 80); return;
+    case 96: __builtin_memcpy(dst, src, 96); return;
+    }
+    memcpy(dst, src, size);
+}
+
+static void buffer_copy(char* dst, const char* src, size_t size)
+{
+#ifdef __SSE2__
+    if (size >= NT_COPY_MIN) {
+        nt_copy(dst, src, size);
+        return;
+    }
+#endif
+    sized_copy(dst, src, size);
+}
+
+/**
+ * Upper bound on the bytes a single flush_daemon_work call may write
+ * before it fsyncs and advances _durable_lsn. Caps how long a batched
+ * flush can defer durability (and thus commit wakeups) during a burst.
+ */
+const long FLUSH_BATCH_MAX = 128 * 1024;
+
 class ticker_thread_t : public smthread_t
 {
 public:
@@ -182,6 +269,7 @@ log_core::fetch(lsn_t& ll, void* buf, lsn_t* nxt, const bool forward)
         // log record can be found in fetch buffer -- no I/O
         size_t i = ll.hi() - _fetch_buf_first;
         if (_fetch_buffers[i]) {
+            INC_TSTAT(log_fetch_buf_hits);
             logrec_t* rp = (logrec_t*) (_fetch_buffers[i] + ll.lo());
             w_assert0(rp->valid_header(ll));
 
@@ -215,7 +303,20 @@ log_core::fetch(lsn_t& ll, void* buf, lsn_t* nxt, const bool forward)
                 }
             }
 
-            memcpy(buf, rp, rp->length());
+            // Scans (analysis, REDO) call fetch in lock-step with
+            // applying each record, so start pulling the next record's
+            // header into cache now; by the time the caller comes back
+            // for it the miss has been overlapped with the apply.
+            // prefetch never faults, so no range check is needed.
+            if (nxt && nxt->hi() == ll.hi()) {
+                __builtin_prefetch(_fetch_buffers[i] + nxt->lo(), 0, 1);
+            }
+
+            // Plain cached stores on purpose: the caller reads the
+            // record immediately, so streaming the copy past the cache
+            // (as the insert path does) would evict it right before
+            // its only reader.
+            sized_copy((char*) buf, (const char*) rp, rp->length());
 
             return RCOK;
         }
@@ -295,7 +396,7 @@ log_core::fetch(lsn_t& ll, void* buf, lsn_t* nxt, const bool forward)
         }
     }
 
-    memcpy(buf, rp, rp->length());
+    sized_copy((char*) buf, (const char*) rp, rp->length());
     p->release_read();
     w_assert0(((logrec_t*) buf)->valid_header(ll));
 
@@ -341,10 +442,14 @@ log_core::log_core(const sm_options& options)
       _start(0),
       _end(0),
       _waiting_for_flush(false),
+      _flush_waiters(NULL),
+      _flush_in_progress(false),
       _shutting_down(false),
       _flush_daemon_running(false)
 {
     _segsize = SEGMENT_SIZE;
+    w_assert1((_segsize & (_segsize - 1)) == 0);
+    _segsize_mask = _segsize - 1;
 
     DO_PTHREAD(pthread_mutex_init(&_wait_flush_lock, NULL));
     DO_PTHREAD(pthread_cond_init(&_wait_cond, NULL));
@@ -376,7 +481,7 @@ log_core::log_core(const sm_options& options)
        return how far into the current segment we are.
         CS: moved this code from the _prime method
      */
-    long offset = _durable_lsn.lo() % segsize();
+    long offset = _durable_lsn.lo() & _segsize_mask;
     long base = _durable_lsn.lo() - offset;
     lsn_t start_lsn(_durable_lsn.hi(), base);
 
@@ -509,23 +614,36 @@ void log_core::_acquire_buffer_space(CArraySlot* info, long recsize)
     */
     // CS: TODO commented out waiting-for-space stuff
     //while(*&_waiting_for_space ||
-    while(
-            end_byte() - start_byte() + recsize > segsize() - 2* log_storage::BLOCK_SIZE)
+    long insert_pos;
+    while (true)
     {
-        _insert_lock.release(&info->me);
+        while(
+                end_byte() - start_byte() + recsize > segsize() - 2* log_storage::BLOCK_SIZE)
         {
-            CRITICAL_SECTION(cs, _wait_flush_lock);
-            while(end_byte() - start_byte() + recsize > segsize() - 2* log_storage::BLOCK_SIZE)
+            _insert_lock.release(&info->me);
             {
-                // CS: changed from waiting_for_space to waiting_for_flush
-                _waiting_for_flush = true;
-                // Use signal since the only thread that should be waiting
-                // on the _flush_cond is the log flush daemon.
-                DO_PTHREAD(pthread_cond_signal(&_flush_cond));
-                DO_PTHREAD(pthread_cond_wait(&_wait_cond, &_wait_flush_lock));
+                CRITICAL_SECTION(cs, _wait_flush_lock);
+                while(end_byte() - start_byte() + recsize > segsize() - 2* log_storage::BLOCK_SIZE)
+                {
+                    // CS: changed from waiting_for_space to waiting_for_flush
+                    _waiting_for_flush = true;
+                    // Use signal since the only thread that should be waiting
+                    // on the _flush_cond is the log flush daemon.
+                    DO_PTHREAD(pthread_cond_signal(&_flush_cond));
+                    DO_PTHREAD(pthread_cond_wait(&_wait_cond, &_wait_flush_lock));
+                }
             }
+            _insert_lock.acquire(&info->me);
         }
-        _insert_lock.acquire(&info->me);
+        // Stop fast-path reservations and pin the insert position. They
+        // might have raced past the space check above, so re-check with
+        // the seal held and wait some more if they consumed our space.
+        insert_pos = _seal_insert_pos();
+        if (insert_pos - start_byte() + recsize
+                <= segsize() - 2* log_storage::BLOCK_SIZE) {
+            break;
+        }
+        _unseal_insert_pos(insert_pos);
     }
     // lfence because someone else might have entered and left during above release/acquire.
     lintel::atomic_thread_fence(lintel::memory_order_consume);
@@ -596,36 +714,38 @@ void log_core::_acquire_buffer_space(CArraySlot* info, long recsize)
    * log.
    */
 
-  /* An epoch fits within a segment */
-    w_assert2(_buf_epoch.end >= 0 && _buf_epoch.end <= segsize());
+    // _buf_epoch.end is no longer authoritative -- fast-path
+    // reservations advance _end without touching the epoch. Since the
+    // seal is held, insert_pos is the true tail of the log buffer.
+    long end = insert_pos - _buf_epoch.base;
 
-  /* end_byte() is the byte-offset-from-start-of-log-file
-   * version of _cur_epoch.end */
-    w_assert2(_buf_epoch.end % segsize() == end_byte() % segsize());
+  /* An epoch fits within a segment */
+    w_assert2(end >= 0 && end <= segsize());
 
-  /* _curr_lsn is the lsn of the next-to-be-inserted log record, i.e.,
-   * the next byte of the log to be written
+  /* No assert against _curr_lsn here: a fast-path reservation may have
+   * CAS'd _end (and been sealed over) before publishing _curr_lsn, so
+   * _curr_lsn can legitimately lag the sealed insert position.  The
+   * epoch-derived lsn computed below is the authoritative one.
    */
-  /* _cur_epoch.end is the offset into the log buffer of the _curr_lsn */
-    w_assert2(_buf_epoch.end % segsize() == _curr_lsn.lo() % segsize());
-  /* _curr_epoch.end should never be > segsize at this point;
+  /* end should never be > segsize at this point;
    * that would indicate a wraparound is in progress when we entered this
    */
-    w_assert2(end_byte() >= start_byte());
+    w_assert2(insert_pos >= start_byte());
 
-    // The following should be true since we waited on a condition
-    // variable while
-    // end_byte() - start_byte() + recsize > segsize() - 2*BLOCK_SIZE
-    w_assert2(end_byte() - start_byte() <= segsize() - 2* log_storage::BLOCK_SIZE);
+    // The following should be true since we re-checked the space
+    // condition after taking the seal
+    w_assert2(insert_pos - start_byte() <= segsize() - 2* log_storage::BLOCK_SIZE);
 
 
-    long end = _buf_epoch.end;
-    long old_end = _buf_epoch.base + end;
+    long old_end = insert_pos;
     long new_end = end + recsize;
     // set spillsize to the portion of the new record that
     // wraps around to the beginning of the log buffer(segment)
     long spillsize = new_end - segsize();
-    lsn_t curr_lsn = _curr_lsn;
+    // _curr_lsn may lag behind the sealed insert position (fast-path
+    // reservations publish it after their CAS), so derive the lsn from
+    // the epoch instead of reading _curr_lsn.
+    lsn_t curr_lsn = _buf_epoch.base_lsn + end;
     lsn_t next_lsn = _buf_epoch.base_lsn + new_end;
     long new_base = -1;
     long start_pos = end;
@@ -651,8 +771,8 @@ void log_core::_acquire_buffer_space(CArraySlot* info, long recsize)
     }
 
     // let the world know
-    _curr_lsn = next_lsn;
-    _end = _buf_epoch.base + new_end;
+    _advance_curr_lsn(next_lsn);
+    _unseal_insert_pos(_buf_epoch.base + new_end);
 
     _carray->join_expose(info);
     _insert_lock.release(&info->me);
@@ -674,12 +794,14 @@ rc_t log_core::truncate()
     // We want exclusive access to the log, so no CArray
     mcs_lock::qnode me;
     _insert_lock.acquire(&me);
+    // also stop lock-free fast-path reservations
+    (void) _seal_insert_pos();
 
     // create new empty epoch at the beginning of the new partition
-    _curr_lsn = first_lsn(_buf_epoch.base_lsn.hi()+1);
+    lsn_t new_lsn = first_lsn(_buf_epoch.base_lsn.hi()+1);
+    _advance_curr_lsn(new_lsn);
     long new_base = _buf_epoch.base + _segsize;
-    _buf_epoch = epoch(_curr_lsn, new_base, 0, 0);
-    _end = new_base;
+    _buf_epoch = epoch(new_lsn, new_base, 0, 0);
 
     // Update epochs so flush daemon can take over
     {
@@ -688,9 +810,10 @@ rc_t log_core::truncate()
         // but here it fails sometimes.
         // w_assert3(_old_epoch.start == _old_epoch.end);
         _old_epoch = _cur_epoch;
-        _cur_epoch = epoch(_curr_lsn, new_base, 0, 0);
+        _cur_epoch = epoch(new_lsn, new_base, 0, 0);
     }
 
+    _unseal_insert_pos(new_base);
     _insert_lock.release(&me);
 
     return RCOK;
@@ -838,23 +961,124 @@ rc_t log_core::_leave_carray(CArraySlot* info, int32_t size)
     return RCOK;
 }
 
+long log_core::_seal_insert_pos()
+{
+    // Only the _insert_lock holder seals, so we race solely against
+    // fast-path reservations.
+    while (true) {
+        int64_t pos = *&_end;
+        w_assert1(!(pos & INSERT_POS_SEAL));
+        int64_t pos_cas_tmp = pos;
+        if (lintel::unsafe::atomic_compare_exchange_strong<int64_t>(
+                    reinterpret_cast<int64_t*>(&_end), &pos_cas_tmp,
+                    pos | INSERT_POS_SEAL)) {
+            return pos;
+        }
+    }
+}
+
+void log_core::_unseal_insert_pos(long pos)
+{
+    // make the epoch changes visible before new reservations can use them
+    lintel::atomic_thread_fence(lintel::memory_order_release);
+    _end = pos;
+}
+
+void log_core::_advance_curr_lsn(lsn_t new_lsn)
+{
+    // CAS-max: concurrent reservations may publish out of order, but
+    // _curr_lsn must never move backwards.
+    while (true) {
+        lsndata_t cur = (*&_curr_lsn).data();
+        if (cur >= new_lsn.data()) {
+            break;
+        }
+        lsndata_t cur_cas_tmp = cur;
+        if (lintel::unsafe::atomic_compare_exchange_strong<lsndata_t>(
+                    reinterpret_cast<lsndata_t*>(&_curr_lsn), &cur_cas_tmp,
+                    new_lsn.data())) {
+            break;
+        }
+    }
+}
+
+bool log_core::_reserve_buffer_space(CArraySlot* info, long recsize)
+{
+    if (CARRAY_RELEASE_DELEGATION) {
+        // delegated buffer release requires joining the expose queue,
+        // which only the C-array path does
+        return false;
+    }
+    while (true) {
+        int64_t pos = *&_end;
+        if (pos & INSERT_POS_SEAL) {
+            // epoch change in progress; consolidate through the C-array
+            return false;
+        }
+        long base = _buf_epoch.vthis()->base;
+        lsn_t base_lsn = _buf_epoch.base_lsn;
+        long end = pos - base;
+        if (end < 0 || end + recsize > segsize()) {
+            // record would wrap the segment (and possibly the
+            // partition); only the C-array leader handles that
+            return false;
+        }
+        if (pos - start_byte() + recsize
+                > segsize() - 2* log_storage::BLOCK_SIZE) {
+            // buffer too full -- slow path waits for the flush daemon
+            return false;
+        }
+        int64_t pos_cas_tmp = pos;
+        if (lintel::unsafe::atomic_compare_exchange_strong<int64_t>(
+                    reinterpret_cast<int64_t*>(&_end), &pos_cas_tmp,
+                    pos + recsize)) {
+            // The CAS is a full barrier, and every epoch change seals
+            // _end before touching _buf_epoch, so base/base_lsn above
+            // are consistent with pos: _end is strictly monotonic and
+            // any intervening change would have failed the CAS.
+            info->lsn = base_lsn + end;
+            info->old_end = pos;
+            info->start_pos = end;
+            info->pos = end + recsize;
+            info->new_end = end + recsize;
+            info->new_base = -1;
+            info->error = w_error_ok;
+            info->count = ConsolidationArray::SLOT_FINISHED;
+            _advance_curr_lsn(base_lsn + (end + recsize));
+            return true;
+        }
+        // lost the race to another reservation -- retry
+    }
+}
+
 rc_t log_core::insert(logrec_t &rec, lsn_t* rlsn)
 {
     w_assert1(rec.length() <= sizeof(logrec_t));
     int32_t size = rec.length();
 
-    CArraySlot* info = NULL;
-    long pos = 0;
-    W_DO(_join_carray(info, pos, size));
-    w_assert1(info);
-
-    // insert my value
     lsn_t rec_lsn;
-    if(!info->error) {
-        rec_lsn = _copy_to_buffer(rec, pos, size, info);
+    CArraySlot fast_slot;
+    if (_reserve_buffer_space(&fast_slot, size)) {
+        // LSN-ordered lock-free reservation: space was claimed with a
+        // single CAS; copy with no lock held and publish the epoch in
+        // reservation order (a group of one, as far as the epoch
+        // machinery is concerned).
+        rec_lsn = _copy_to_buffer(rec, 0, size, &fast_slot);
+        _update_epochs(&fast_slot);
     }
+    else {
+        CArraySlot* info = NULL;
+        long pos = 0;
+        W_DO(_join_carray(info, pos, size));
+        w_assert1(info);
 
-    W_DO(_leave_carray(info, size));
+        // insert my value
+        if(!info->error) {
+            rec_lsn = _copy_to_buffer(rec, pos, size, info);
+        }
+
+        W_DO(_leave_carray(info, size));
+    }
 
     if(rlsn) {
         *rlsn = rec_lsn;
@@ -876,7 +1100,7 @@ void log_core::_copy_raw(CArraySlot* info, long& pos, const char* data,
     long spillsize = pos + size - _segsize;
     if(spillsize <= 0) {
         // normal insert
-        memcpy(_buf+pos, data, size);
+        buffer_copy(_buf+pos, data, size);
     }
     else {
         // spillsize > 0 so we are wrapping.
@@ -895,8 +1119,8 @@ void log_core::_copy_raw(CArraySlot* info, long& pos, const char* data,
 
         // Copy log record to buffer
         // memcpy : areas do not overlap
-        memcpy(_buf+pos, data, partsize);
-        memcpy(_buf, data+partsize, spillsize);
+        buffer_copy(_buf+pos, data, partsize);
+        buffer_copy(_buf, data+partsize, spillsize);
     }
 }
 
@@ -947,13 +1171,63 @@ rc_t log_core::flush(const lsn_t &to_lsn, bool block, bool signal, bool *ret_flu
             }
             if (ret_flushed) *ret_flushed = false; // not yet flushed
         }  else {
+            // Aether-style group commit: if no flush is currently in
+            // flight, this thread becomes the flusher for everything
+            // queued so far instead of signaling the daemon and going
+            // to sleep -- saves two context switches per commit.
+            if (!lintel::unsafe::atomic_exchange<bool>(&_flush_in_progress, true)) {
+                (void) flush_daemon_work(*&_durable_lsn);
+                lintel::unsafe::atomic_exchange<bool>(&_flush_in_progress, false);
+                CRITICAL_SECTION(cs, _wait_flush_lock);
+                // Pair the stolen flush with the wakeup/clear the daemon
+                // does after its own flushes: buffer-space waiters in
+                // _acquire_buffer_space sleep on _wait_cond, and the
+                // daemon's broadcast is gated on it having flushed
+                // something itself.  Without this, _waiting_for_flush
+                // stays stuck and the daemon busy-spins instead of
+                // sleeping once inserts stop.
+                if (*&_waiting_for_flush) {
+                    _waiting_for_flush = false;
+                    DO_PTHREAD(pthread_cond_broadcast(&_wait_cond));
+                }
+                _wake_durable_waiters();
+                if (_flush_waiters) {
+                    // unsatisfied commit waiters -- hand them back to
+                    // the daemon
+                    _waiting_for_flush = true;
+                    DO_PTHREAD(pthread_cond_signal(&_flush_cond));
+                }
+                if (lsn < *&_durable_lsn) {
+                    if (ret_flushed) *ret_flushed = true;
+                    return RCOK;
+                }
+                // our lsn fell beyond the flush batch limit -- fall
+                // through and wait for the daemon like everyone else
+            }
             CRITICAL_SECTION(cs, _wait_flush_lock);
-            while(lsn >= *&_durable_lsn) {
+            if (lsn >= *&_durable_lsn) {
+                // Enqueue ourselves with the target lsn and sleep on a
+                // private condition variable. The flush daemon wakes us
+                // once it has hardened our lsn -- nobody else is woken
+                // up for flushes that don't cover their commit point.
+                flush_waiter_t me;
+                me.lsn = lsn;
+                me.next = _flush_waiters;
+                me.satisfied = false;
+                DO_PTHREAD(pthread_cond_init(&me.cond, NULL));
+                _flush_waiters = &me;
                 *&_waiting_for_flush = true;
                 // Use signal since the only thread that should be waiting
                 // on the _flush_cond is the log flush daemon.
                 DO_PTHREAD(pthread_cond_signal(&_flush_cond));
-                DO_PTHREAD(pthread_cond_wait(&_wait_cond, &_wait_flush_lock));
+                // The daemon unlinks us before signaling, so waiting for
+                // 'satisfied' guarantees the node is off the list when
+                // this frame goes away.
+                while (!me.satisfied) {
+                    DO_PTHREAD(pthread_cond_wait(&me.cond, &_wait_flush_lock));
+                }
+                w_assert1(lsn < *&_durable_lsn);
+                DO_PTHREAD(pthread_cond_destroy(&me.cond));
             }
             if (ret_flushed) *ret_flushed = true;// now flushed!
         }
@@ -992,6 +1266,15 @@ void log_core::flush_daemon()
                 DO_PTHREAD(pthread_cond_broadcast(&_wait_cond));
                 // wake up anyone waiting on log flush
             }
+            if (success) {
+                // flush pipelining: wake exactly the commit waiters
+                // whose lsn the last flush made durable
+                _wake_durable_waiters();
+            }
+            if (_flush_waiters) {
+                // unsatisfied commit waiters -- keep the daemon going
+                _waiting_for_flush = true;
+            }
             if(_shutting_down) {
                 _shutting_down = false;
                 break;
@@ -1012,8 +1295,14 @@ void log_core::flush_daemon()
         }
 
         // flush all records later than last_completed_flush_lsn
-        // and return the resulting last durable lsn
+        // and return the resulting last durable lsn. An elected
+        // committer (see flush()) may be mid-flush; wait for it, since
+        // flushers must be serialized.
+        while (lintel::unsafe::atomic_exchange<bool>(&_flush_in_progress, true)) {
+            sthread_t::yield();
+        }
         lsn_t lsn = flush_daemon_work(last_completed_flush_lsn);
+        lintel::unsafe::atomic_exchange<bool>(&_flush_in_progress, false);
 
         // success=true if we wrote anything
         success = (lsn != last_completed_flush_lsn);
@@ -1021,10 +1310,33 @@ void log_core::flush_daemon()
     }
 
     // make sure the buffer is completely empty before leaving...
+    while (lintel::unsafe::atomic_exchange<bool>(&_flush_in_progress, true)) {
+        sthread_t::yield();
+    }
     for(lsn_t lsn;
         (lsn=flush_daemon_work(last_completed_flush_lsn)) !=
                 last_completed_flush_lsn;
         last_completed_flush_lsn=lsn) ;
+    lintel::unsafe::atomic_exchange<bool>(&_flush_in_progress, false);
+}
+
+/**\brief Wake commit waiters whose lsn the last flush made durable.
+ * \details Caller must hold _wait_flush_lock.
+ */
+void log_core::_wake_durable_waiters()
+{
+    flush_waiter_t** prev = &_flush_waiters;
+    while (*prev) {
+        flush_waiter_t* w = *prev;
+        if (w->lsn < *&_durable_lsn) {
+            *prev = w->next;
+            w->satisfied = true;
+            DO_PTHREAD(pthread_cond_signal(&w->cond));
+        }
+        else {
+            prev = &w->next;
+        }
+    }
 }
 
 /**\brief Flush unflushed-portion of log buffer.
@@ -1044,104 +1356,147 @@ void log_core::flush_daemon()
  */
 lsn_t log_core::flush_daemon_work(lsn_t old_mark)
 {
-    lsn_t base_lsn_before, base_lsn_after;
-    long base, start1, end1, start2, end2;
-    {
-        CRITICAL_SECTION(cs, _flush_lock);
-        base_lsn_before = _old_epoch.base_lsn;
-        base_lsn_after = _cur_epoch.base_lsn;
-        base = _cur_epoch.base;
-
-        // The old_epoch is valid (needs flushing) iff its end > start.
-        // The old_epoch is valid id two cases, both when
-        // insert wrapped thelog buffer
-        // 1) by doing so reached the end of the partition,
-        //     In this case, the old epoch might not be an entire
-        //     even segment size
-        // 2) still room in the partition
-        //     In this case, the old epoch is exactly 1 segment in size.
-
-        if(_old_epoch.start == _old_epoch.end) {
-            // no wrap -- flush only the new
-            w_assert1(_cur_epoch.end >= _cur_epoch.start);
-            start2 = _cur_epoch.start;
-            end2 = _cur_epoch.end;
-            w_assert1(end2 >= start2);
-            // false alarm?
-            if(start2 == end2) {
-                return old_mark;
+    lsn_t durable_mark = old_mark;
+    long unsynced = 0;
+    std::shared_ptr<partition_t> p;
+
+    // Batch consecutive flushes into one fsync: keep writing as long as
+    // inserts keep producing (and we stay under FLUSH_BATCH_MAX), then
+    // sync once and publish the whole batch as durable.
+    while (true) {
+        lsn_t base_lsn_before, base_lsn_after;
+        long base, start1, end1, start2, end2;
+        {
+            CRITICAL_SECTION(cs, _flush_lock);
+            base_lsn_before = _old_epoch.base_lsn;
+            base_lsn_after = _cur_epoch.base_lsn;
+            base = _cur_epoch.base;
+
+            // The old_epoch is valid (needs flushing) iff its end > start.
+            // The old_epoch is valid id two cases, both when
+            // insert wrapped thelog buffer
+            // 1) by doing so reached the end of the partition,
+            //     In this case, the old epoch might not be an entire
+            //     even segment size
+            // 2) still room in the partition
+            //     In this case, the old epoch is exactly 1 segment in size.
+
+            if(_old_epoch.start == _old_epoch.end) {
+                // no wrap -- flush only the new
+                w_assert1(_cur_epoch.end >= _cur_epoch.start);
+                start2 = _cur_epoch.start;
+                end2 = _cur_epoch.end;
+                w_assert1(end2 >= start2);
+                // false alarm? nothing (left) to flush
+                if(start2 == end2) {
+                    break;
+                }
+                _cur_epoch.start = end2;
+
+                start1 = start2; // fake start1 so the start_lsn calc below works
+                end1 = start2;
+
+                base_lsn_before = base_lsn_after;
             }
-            _cur_epoch.start = end2;
+            else if(base_lsn_before.file() == base_lsn_after.file()) {
+                // wrapped within partition -- flush both
+                start2 = _cur_epoch.start;
+                // race here with insert setting _curr_epoch.end, but
+                // it won't matter. Since insert already did the memcpy,
+                // we are safe and can flush the entire amount.
+                end2 = _cur_epoch.end;
+                _cur_epoch.start = end2;
+
+                start1 = _old_epoch.start;
+                end1 = _old_epoch.end;
+                _old_epoch.start = end1;
+
+                w_assert1(base_lsn_before + segsize() == base_lsn_after);
+            }
+            else {
+                // new partition -- flushing only the old since the
+                // two epochs target different files. The next loop
+                // iteration picks up the new epoch.
+                start2 = 0;
+                end2 = 0; // don't fake end2 because end_lsn needs to see '0'
 
-            start1 = start2; // fake start1 so the start_lsn calc below works
-            end1 = start2;
+                start1 = _old_epoch.start;
+                end1 = _old_epoch.end;
 
-            base_lsn_before = base_lsn_after;
-        }
-        else if(base_lsn_before.file() == base_lsn_after.file()) {
-            // wrapped within partition -- flush both
-            start2 = _cur_epoch.start;
-            // race here with insert setting _curr_epoch.end, but
-            // it won't matter. Since insert already did the memcpy,
-            // we are safe and can flush the entire amount.
-            end2 = _cur_epoch.end;
-            _cur_epoch.start = end2;
-
-            start1 = _old_epoch.start;
-            end1 = _old_epoch.end;
-            _old_epoch.start = end1;
-
-            w_assert1(base_lsn_before + segsize() == base_lsn_after);
-        }
-        else {
-            // new partition -- flushing only the old since the
-            // two epochs target different files. Let the next
-            // flush handle the new epoch.
-            start2 = 0;
-            end2 = 0; // don't fake end2 because end_lsn needs to see '0'
+                // Mark the old epoch has no longer valid.
+                _old_epoch.start = end1;
 
-            start1 = _old_epoch.start;
-            end1 = _old_epoch.end;
+                w_assert1(base_lsn_before.file()+1 == base_lsn_after.file());
+            }
+        } // end critical section
 
-            // Mark the old epoch has no longer valid.
-            _old_epoch.start = end1;
+        lsn_t start_lsn = base_lsn_before + start1;
+        lsn_t end_lsn   = base_lsn_after + end2;
+        long  new_start = base + end2;
+        {
+            // Avoid interference with compensations.
+            CRITICAL_SECTION(cs, _comp_lock);
+            _flush_lsn = end_lsn;
+        }
 
-            w_assert1(base_lsn_before.file()+1 == base_lsn_after.file());
+        w_assert1(end1 >= start1);
+        w_assert1(end2 >= start2);
+        w_assert1(end_lsn == first_lsn(start_lsn.hi()+1)
+              || end_lsn.lo() - start_lsn.lo() == (end1-start1) + (end2-start2));
+
+        // start_lsn.file() determines partition # and whether code
+        // will open a new partition into which to flush.
+        // That, in turn, is determined by whether the _old_epoch.base_lsn.file()
+        // matches the _cur_epoch.base_lsn.file()
+        // CS: This code used to be on the method _flushX
+        auto q = _storage->get_partition_for_flush(start_lsn, start1, end1,
+                start2, end2);
+
+        if (p && p != q) {
+            // Crossing a partition boundary -- the batch so far went to
+            // a different file; sync it before writing into the new one.
+            p->sync_append();
+            _durable_lsn = durable_mark;
         }
-    } // end critical section
+        p = q;
 
-    lsn_t start_lsn = base_lsn_before + start1;
-    lsn_t end_lsn   = base_lsn_after + end2;
-    long  new_start = base + end2;
-    {
-        // Avoid interference with compensations.
-        CRITICAL_SECTION(cs, _comp_lock);
-        _flush_lsn = end_lsn;
-    }
+        // Flush the log buffer. The fsync is deferred to the end of the
+        // batch (or the partition switch above).
+        W_COERCE(p->flush(start_lsn, _buf, start1, end1, start2, end2,
+                    false /* sync */));
 
-    w_assert1(end1 >= start1);
-    w_assert1(end2 >= start2);
-    w_assert1(end_lsn == first_lsn(start_lsn.hi()+1)
-          || end_lsn.lo() - start_lsn.lo() == (end1-start1) + (end2-start2));
+        long written = (end2 - start2) + (end1 - start1);
+        p->set_size(start_lsn.lo()+written);
 
-    // start_lsn.file() determines partition # and whether code
-    // will open a new partition into which to flush.
-    // That, in turn, is determined by whether the _old_epoch.base_lsn.file()
-    // matches the _cur_epoch.base_lsn.file()
-    // CS: This code used to be on the method _flushX
-    auto p = _storage->get_partition_for_flush(start_lsn, start1, end1,
-            start2, end2);
+        durable_mark = end_lsn;
+        _start = new_start;
+        unsynced += written;
 
-    // Flush the log buffer
-    W_COERCE(p->flush(start_lsn, _buf, start1, end1, start2, end2));
+        if (unsynced >= FLUSH_BATCH_MAX) {
+            break;
+        }
+    }
 
-    long written = (end2 - start2) + (end1 - start1);
-    p->set_size(start_lsn.lo()+written);
+    if (durable_mark != old_mark) {
+        w_assert1(p);
+        p->sync_append();
+        _durable_lsn = durable_mark;
+    }
 
-    _durable_lsn = end_lsn;
-    _start = new_start;
+    return durable_mark;
+}
 
-    return end_lsn;
+// Rare-case diagnostic, kept out of line so the compensate hot path
+// stays compact (the common case is a handful of compares plus the
+// in-place set_clr).
+static void _report_compensate_mismatch(const logrec_t* s, lsn_t lsn_ck,
+        const lsn_t& orig_lsn)
+{
+    // this is a pretty rare occurrence, and I haven't been able
+    // to figure out whether it's actually a bug
+    cerr << endl << "lsn_ck = "<<lsn_ck.hi()<<"."<<lsn_ck.lo()<<", orig_lsn = "<<orig_lsn.hi()<<"."<<orig_lsn.lo()<<endl
+        << __LINE__ << " " __FILE__ << " "
+        << "log rec is  " << *s << endl;
 }
 
 // Find the log record at orig_lsn and turn it into a compensation
@@ -1178,7 +1533,7 @@ rc_t log_core::compensate(const lsn_t& orig_lsn, const lsn_t& undo_lsn)
        size from the current _flush_lsn -- nothing newer can be
        overwritten until we release the mutex.
      */
-    long pos = orig_lsn.lo() % segsize();
+    long pos = orig_lsn.lo() & _segsize_mask;
     if(pos >= segsize() - logrec_t::hdr_non_ssx_sz)
         return RC(eBADCOMPENSATION); // split record. forget it.
 
@@ -1197,12 +1552,8 @@ rc_t log_core::compensate(const lsn_t& orig_lsn, const lsn_t& undo_lsn)
 
     lsn_t lsn_ck = s->get_lsn_ck();
     if(lsn_ck != orig_lsn) {
-        // this is a pretty rare occurrence, and I haven't been able
-        // to figure out whether it's actually a bug
-        cerr << endl << "lsn_ck = "<<lsn_ck.hi()<<"."<<lsn_ck.lo()<<", orig_lsn = "<<orig_lsn.hi()<<"."<<orig_lsn.lo()<<endl
-            << __LINE__ << " " __FILE__ << " "
-            << "log rec is  " << *s << endl;
-                return RC(eBADCOMPENSATION);
+        _report_compensate_mismatch(s, lsn_ck, orig_lsn);
+        return RC(eBADCOMPENSATION);
     }
     if (!s->is_single_sys_xct()) {
         w_assert1(s->xid_prev() == lsn_t::null || s->xid_prev() >= undo_lsn);
@@ -1217,6 +1568,16 @@ rc_t log_core::compensate(const lsn_t& orig_lsn, const lsn_t& undo_lsn)
     return RCOK;
 }
 
+/*
+ * Read every partition the recovery passes will touch into memory,
+ * once. This is what keeps restart from paying for the log scan twice:
+ * the backward analysis scan and the forward redo scan both resolve
+ * their fetches against these buffers, so the log device sees a single
+ * sequential read regardless of how many passes walk the records.
+ * (Fusing the passes themselves is not an option here -- analysis runs
+ * backward and a record's redo-worthiness is only known once analysis
+ * has seen the whole tail.)
+ */
 rc_t log_core::load_fetch_buffers()
 {
     _fetch_buffers.resize(_fetch_buf_last - _fetch_buf_first + 1, NULL);
@@ -1239,6 +1600,10 @@ rc_t log_core::load_fetch_buffers()
         _fetch_buffers[p - _fetch_buf_first] = buf;
         W_DO(me()->open(fname.c_str(), flags, 0744, fd));
 
+        // the whole partition is about to be read -- hint the kernel
+        // so read-ahead runs ahead of the pread loop below
+        (void) me()->fadvise(fd, 0, 0, smthread_t::ADVISE_WILLNEED);
+
         // Main loop that loads chunks of 32MB in reverse sequential order
         size_t chunk = 32 * 1024 * 1024;
         long offset = file_info.st_size - chunk;
@@ -80,7 +80,9 @@ class fetch_buffer_loader_t;
 #include "tatas.h"
 #include "log_storage.h"
 
-class log_core
+// Marked final: there is a single log buffer implementation, so the
+// compiler may devirtualize calls through log_core pointers.
+class log_core final
 {
     // CArray interface needs to be exposed to plog_xct_t to implement
     // atomic commit protocol.
@@ -156,7 +158,15 @@ protected:
 
     ticker_thread_t* _ticker;
 
+    /*
+     * Keep insert-side and flush-side hot words on distinct cachelines:
+     * _curr_lsn and _end are hammered by inserting threads (CAS), while
+     * _durable_lsn and _start are stored by the flush daemon and polled
+     * by committers. Sharing a line makes every insert CAS invalidate
+     * the committers' reads and vice versa.
+     */
     lsn_t           _curr_lsn;
+    /** @cond */ char    _padding_lsn[CACHELINE_SIZE]; /** @endcond */
     lsn_t           _durable_lsn;
 
     // Set of pointers into _buf (circular log buffer)
@@ -186,7 +196,11 @@ protected:
      * \ingroup CARRAY
      *  @{
      */
+    // _buf_epoch belongs to the insert side (guarded by _insert_lock,
+    // read by the reservation fast path); _cur/_old_epoch to the flush
+    // side (guarded by _flush_lock) -- keep them apart as well
     epoch                _buf_epoch;
+    /** @cond */ char    _padding_epoch[CACHELINE_SIZE]; /** @endcond */
     epoch                _cur_epoch;
     epoch                _old_epoch;
 
@@ -196,6 +210,29 @@ protected:
     rc_t _join_carray(CArraySlot*& info, long& pos, int32_t size);
     rc_t _leave_carray(CArraySlot* info, int32_t size);
     void _copy_raw(CArraySlot* info, long& pos, const char* data, size_t size);
+
+    /**
+     * Lock-free insert reservation (fast path).
+     * Claims recsize bytes of buffer space with a single CAS on _end and
+     * fills \e info with the same bookkeeping a C-array leader would have
+     * produced for a group of one. Returns false when the record would
+     * wrap the current segment, the buffer is too full, or an epoch
+     * change is in progress (_end sealed), in which case the caller must
+     * consolidate through the C-array as before.
+     */
+    bool _reserve_buffer_space(CArraySlot* info, long recsize);
+    /**
+     * Seals _end against fast-path reservations; must hold _insert_lock.
+     * Returns the insert position that was current when the seal took
+     * effect. Every epoch change (segment wrap, partition switch,
+     * truncation) seals _end first so that a successful fast-path CAS
+     * proves the epoch snapshot it read was consistent.
+     */
+    long _seal_insert_pos();
+    /** Publishes the new insert position, lifting the seal. */
+    void _unseal_insert_pos(long pos);
+    /** Monotonic (CAS-max) advance of _curr_lsn; inserts race on this. */
+    void _advance_curr_lsn(lsn_t new_lsn);
     /** @}*/
 
     log_storage*    _storage;
@@ -206,12 +243,20 @@ protected:
     long _start; // byte number of oldest unwritten byte
     long                 start_byte() const { return _start; }
 
+    /** @cond */ char    _padding_end[CACHELINE_SIZE]; /** @endcond */
     long _end; // byte number of insertion point
     long                 end_byte() const { return _end; }
 
+    // every inserter reads _segsize; don't let the _end CAS above or
+    // the _flush_lsn stores below keep knocking it out of their caches
+    /** @cond */ char    _padding_segsize[CACHELINE_SIZE]; /** @endcond */
     long _segsize; // log buffer size
+    long _segsize_mask; // _segsize - 1; _segsize is a power of two, so
+                        // "lsn.lo() % segsize()" becomes a single AND
 
+    /** @cond */ char    _padding_flush_lsn[CACHELINE_SIZE]; /** @endcond */
     lsn_t                _flush_lsn;
+    /** @cond */ char    _padding_flush_lsn2[CACHELINE_SIZE]; /** @endcond */
 
     /** \ingroup CARRAY */
 
@@ -263,10 +308,14 @@ protected:
      */
 
     /** @cond */ char    _padding[CACHELINE_SIZE]; /** @endcond */
-    tatas_lock           _flush_lock;
-    /** @cond */ char    _padding2[CACHELINE_TATAS_PADDING]; /** @endcond */
-    tatas_lock           _comp_lock;
-    /** @cond */ char    _padding3[CACHELINE_TATAS_PADDING]; /** @endcond */
+    // MCS rather than test-and-test-and-set: under contention every
+    // waiter spins on its own stack qnode instead of thrashing the
+    // lock's cacheline, so a handover costs O(1) traffic regardless of
+    // the number of waiters (same reason _insert_lock is MCS)
+    mcs_lock             _flush_lock;
+    /** @cond */ char    _padding2[CACHELINE_MCS_PADDING]; /** @endcond */
+    mcs_lock             _comp_lock;
+    /** @cond */ char    _padding3[CACHELINE_MCS_PADDING]; /** @endcond */
     /** Lock to protect threads acquiring their log buffer. */
     mcs_lock             _insert_lock;
     /** @cond */ char    _padding4[CACHELINE_MCS_PADDING]; /** @endcond */
@@ -278,6 +327,31 @@ protected:
 
     bool _waiting_for_flush; // protected by log_m::_wait_flush_lock
 
+    /**
+     * Commit waiter for flush pipelining. One per blocked flush() call,
+     * allocated on the caller's stack and linked into _flush_waiters
+     * under _wait_flush_lock. The flush daemon wakes only the waiters
+     * whose lsn has become durable, instead of broadcasting to every
+     * committer on every flush.
+     */
+    struct flush_waiter_t {
+        lsn_t            lsn;
+        pthread_cond_t   cond;
+        flush_waiter_t*  next;
+        bool             satisfied;
+    };
+    /** Head of commit-waiter list; protected by _wait_flush_lock. */
+    flush_waiter_t*      _flush_waiters;
+
+    /** Wake the commit waiters whose lsn is now durable.
+     * Caller must hold _wait_flush_lock. */
+    void _wake_durable_waiters();
+
+    /** True while some thread -- the daemon or an elected committer
+     * (see flush()) -- is inside flush_daemon_work. Flushers must be
+     * serialized because _durable_lsn may only advance in order. */
+    bool                 _flush_in_progress;
+
     sthread_t*           _flush_daemon;
     /// @todo both of the below should become std::atomic_flag's at some time
     lintel::Atomic<bool> _shutting_down;
@@ -25,6 +25,37 @@ void page_evict_log::redo(fixable_page_h* page) {
     bp.set_emlsn_general(dp->_child_slot, dp->_child_lsn);
 }
 
+/*
+ * Per-thread grow-only buffer for collecting a page's log-record chain.
+ * Single-page recovery runs once per page fixed during instant restart,
+ * so workers recover thousands of pages back to back; reusing the
+ * buffer across invocations saves a 256KB new[]/delete[] pair (and the
+ * corresponding page faults) on every one of them.
+ */
+struct spr_buffer_t {
+    char* buf;
+    size_t capacity;
+
+    spr_buffer_t() : buf(NULL), capacity(0) {}
+    ~spr_buffer_t() { delete[] buf; }
+
+    char* ensure(size_t cap)
+    {
+        if (capacity < cap) {
+            char* tmp = new char[cap];
+            if (buf) {
+                memcpy(tmp, buf, capacity);
+                delete[] buf;
+            }
+            buf = tmp;
+            capacity = cap;
+        }
+        return buf;
+    }
+};
+
+static thread_local spr_buffer_t tls_spr_buffer;
+
 // CS TODO: why isnt this in restart.cpp??
 void restart_m::dump_page_lsn_chain(std::ostream &o, const PageID &pid, const lsn_t &max_lsn)
 {
@@ -87,7 +118,6 @@ rc_t restart_m::recover_single_page(fixable_page_h &p, const lsn_t& emlsn)
     w_assert1(buffer);
 
     W_DO(_apply_spr_logs(p, buffer, lr_offsets));
-    delete[] buffer;
 
     w_assert0(p.lsn() == emlsn);
     DBGOUT1(<< "Single-Page-Recovery done for page " << p.pid());
@@ -105,11 +135,12 @@ rc_t restart_m::_collect_spr_logs(
     // make sure log is durable until the lsn we're trying to fetch
     smlevel_0::log->flush(emlsn);
 
-    // Allocate initial buffer -- expand later if needed
-    // CS: regular allocation is fine since SPR isn't such a critical operation
+    // Grab the thread-local buffer -- expand later if needed.
+    // The buffer is owned by the thread and reused across invocations;
+    // the caller must not free it.
     size_t buffer_capacity = 1 << 18; // start with 256KB
-    // must be freed by caller
-    buffer = new char[buffer_capacity];
+    buffer = tls_spr_buffer.ensure(buffer_capacity);
+    buffer_capacity = tls_spr_buffer.capacity;
     size_t pos = 0;
 
     lsn_t nxt = emlsn;
@@ -130,10 +161,7 @@ rc_t restart_m::_collect_spr_logs(
         if (sizeof(logrec_t) > buffer_capacity - pos) {
             DBGOUT1(<< "Doubling SPR buffer capacity");
             buffer_capacity *= 2;
-            char* tmp = new char[buffer_capacity];
-            memcpy(tmp, buffer, buffer_capacity/2);
-            delete[] buffer;
-            buffer = tmp;
+            buffer = tls_spr_buffer.ensure(buffer_capacity);
             lr = (logrec_t*) (buffer + pos);
             w_assert1(lr->length() <= buffer_capacity - pos);
         }
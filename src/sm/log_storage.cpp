@@ -35,6 +35,8 @@ const string log_storage::log_prefix = "log.";
 const string log_storage::log_regex = "log\\.[1-9][0-9]*";
 const string log_storage::chkpt_prefix = "chkpt_";
 const string log_storage::chkpt_regex = "chkpt_[1-9][0-9]*\\.[1-9][0-9]*";
+const string log_storage::prealloc_prefix = "prealloc_";
+const string log_storage::prealloc_regex = "prealloc_[1-9][0-9]*";
 
 class partition_recycler_t : public smthread_t
 {
@@ -68,6 +70,45 @@ public:
     std::mutex _recycler_mutex;
 };
 
+class partition_prealloc_t : public smthread_t
+{
+public:
+    partition_prealloc_t(log_storage* storage)
+        : smthread_t(t_regular, "partition_prealloc"), storage(storage),
+        retire(false), kicked(false)
+    {}
+
+    virtual ~partition_prealloc_t() {}
+
+    void run()
+    {
+        while (!retire) {
+            {
+                unique_lock<mutex> lck(_prealloc_mutex);
+                // check kicked so a wakeup issued before we got here
+                // (e.g. right after fork) is not lost
+                while (!kicked && !retire) { _prealloc_condvar.wait(lck); }
+                kicked = false;
+            }
+            if (retire) { break; }
+            storage->prealloc_next_partition();
+        }
+    }
+
+    void wakeup()
+    {
+        unique_lock<mutex> lck(_prealloc_mutex);
+        kicked = true;
+        _prealloc_condvar.notify_one();
+    }
+
+    log_storage* storage;
+    std::atomic<bool> retire;
+    bool kicked;
+    std::condition_variable _prealloc_condvar;
+    std::mutex _prealloc_mutex;
+};
+
 /*
  * Opens log files in logdir and initializes partitions as well as the
  * given LSN's. The buffer given in prime_buf is primed with the contents
@@ -76,7 +117,8 @@ public:
  */
 log_storage::log_storage(const sm_options& options)
     :
-        _skip_log(new skip_log)
+        _skip_log(new skip_log),
+        _reclaim_gen(0)
 {
     std::string logdir = options.get_string_option("sm_logdir", "log");
     if (logdir.empty()) {
@@ -108,11 +150,14 @@ log_storage::log_storage(const sm_options& options)
 
     _delete_old_partitions = options.get_bool_option("sm_log_delete_old_partitions", true);
 
+    _prealloc_partitions = options.get_bool_option("sm_log_prealloc_partitions", true);
+
     partition_number_t  last_partition = 1;
 
     fs::directory_iterator it(_logpath), eod;
     boost::regex log_rx(log_regex, boost::regex::basic);
     boost::regex chkpt_rx(chkpt_regex, boost::regex::basic);
+    boost::regex prealloc_rx(prealloc_regex, boost::regex::basic);
     for (; it != eod; it++) {
         fs::path fpath = it->path();
         string fname = fpath.filename().string();
@@ -141,6 +186,12 @@ log_storage::log_storage(const sm_options& options)
             ss >> lsn;
             _checkpoints.push_back(lsn);
         }
+        else if (boost::regex_match(fname, prealloc_rx)) {
+            // leftover pre-allocated partition file; its number may be
+            // stale, so just reclaim the space and start over
+            fs::remove(fpath);
+            continue;
+        }
         else {
             cerr << "log_storage: cannot parse filename " << fname << endl;
             W_FATAL(fcINTERNAL);
@@ -169,6 +220,9 @@ log_storage::log_storage(const sm_options& options)
     if (_checkpoints.size() > 0) {
         std::sort(_checkpoints.begin(), _checkpoints.end());
     }
+
+    // get a head start on the first partition switch
+    wakeup_preallocator();
 }
 
 log_storage::~log_storage()
@@ -180,6 +234,13 @@ log_storage::~log_storage()
         _recycler_thread = nullptr;
     }
 
+    if (_prealloc_thread) {
+        _prealloc_thread->retire = true;
+        _prealloc_thread->wakeup();
+        _prealloc_thread->join();
+        _prealloc_thread = nullptr;
+    }
+
     spinlock_write_critical_section cs(&_partition_map_latch);
 
     partition_map_t::iterator it = _partitions.begin();
@@ -223,9 +284,51 @@ shared_ptr<partition_t> log_storage::get_partition_for_flush(lsn_t start_lsn,
 
 shared_ptr<partition_t> log_storage::get_partition(partition_number_t n) const
 {
+    // Log scans (recovery, archiver, rollback) look up the same
+    // partition thousands of times in a row; remember the last hit per
+    // thread so the common case skips the latch and the map walk.
+    //
+    // The cache holds a weak_ptr, not a shared_ptr: delete_old_
+    // partitions reclaims a partition by erasing it from the map and
+    // spin-waiting until its refcount drops to one, so a strong
+    // reference parked in an idle thread's TLS slot would pin the
+    // count and wedge the recycler forever. The weak reference adds
+    // nothing to the count while the thread is not in this function.
+    //
+    // A hit is only trusted if no reclamation ran since the entry was
+    // cached (_reclaim_gen unchanged). lock() is taken before the
+    // generation check: once our strong reference exists, any recycler
+    // that has not yet passed its unique() test will wait for us, and
+    // if one already passed it, its generation bump is visible here
+    // and we discard the reference without ever dereferencing it.
+    static thread_local const log_storage* cached_owner = nullptr;
+    static thread_local partition_number_t cached_num = 0;
+    static thread_local unsigned cached_gen = 0;
+    static thread_local weak_ptr<partition_t> cached_p;
+
+    if (cached_owner == this && cached_num == n) {
+        shared_ptr<partition_t> p = cached_p.lock();
+        if (p && _reclaim_gen.load(std::memory_order_acquire) == cached_gen) {
+            return p;
+        }
+    }
+
     spinlock_read_critical_section cs(&_partition_map_latch);
     partition_map_t::const_iterator it = _partitions.find(n);
-    if (it == _partitions.end()) { return nullptr; }
+    if (it == _partitions.end()) {
+        // drop any stale entry so it cannot outlive the lookup that
+        // discovered the partition is gone
+        cached_p.reset();
+        cached_owner = nullptr;
+        return nullptr;
+    }
+
+    cached_owner = this;
+    cached_num = n;
+    // stable while we hold the read latch: the generation only moves
+    // under the write latch
+    cached_gen = _reclaim_gen.load(std::memory_order_relaxed);
+    cached_p = it->second;
     return it->second;
 }
 
@@ -351,6 +454,13 @@ shared_ptr<partition_t> log_storage::create_partition(partition_number_t pnum)
         W_FATAL_MSG(eINTERNAL, << "Partition " << pnum << " already exists");
     }
 
+    // Adopt the pre-allocated file if the pre-allocator got this far
+    // ahead; otherwise open_for_append simply creates it from scratch.
+    fs::path prealloc_path = make_prealloc_path(pnum);
+    if (fs::exists(prealloc_path)) {
+        fs::rename(prealloc_path, make_log_path(pnum));
+    }
+
     p = make_shared<partition_t>(this, pnum);
     p->set_size(0);
 
@@ -373,6 +483,7 @@ shared_ptr<partition_t> log_storage::create_partition(partition_number_t pnum)
         }
     }
     wakeup_recycler();
+    wakeup_preallocator();
 
     // The check below does not require the mutex
     if (_max_partitions > 0 && _partitions.size() > _max_partitions) {
@@ -394,6 +505,51 @@ void log_storage::wakeup_recycler()
     _recycler_thread->wakeup();
 }
 
+void log_storage::wakeup_preallocator()
+{
+    if (!_prealloc_partitions) { return; }
+
+    if (!_prealloc_thread) {
+        _prealloc_thread.reset(new partition_prealloc_t(this));
+        _prealloc_thread->fork();
+    }
+    _prealloc_thread->wakeup();
+}
+
+/*
+ * Reserve the extents of the next partition file ahead of time, so that
+ * appends after the partition switch do not stall on block allocation.
+ * Runs in the pre-allocator thread; the flush daemon adopts the file in
+ * create_partition via a cheap rename.
+ */
+void log_storage::prealloc_next_partition()
+{
+    partition_number_t next;
+    {
+        spinlock_read_critical_section cs(&_partition_map_latch);
+        if (!_curr_partition) { return; }
+        next = _curr_partition->num() + 1;
+    }
+
+    fs::path fpath = make_prealloc_path(next);
+    if (fs::exists(fpath) || fs::exists(make_log_path(next))) { return; }
+
+    int fd, flags = smthread_t::OPEN_RDWR | smthread_t::OPEN_CREATE;
+    W_COERCE(me()->open(fpath.string().c_str(), flags, 0744, fd));
+    // KEEP_SIZE semantics: st_size stays zero, so the size scan at
+    // startup is unaffected if we crash before the file sees data
+    w_rc_t e = me()->fallocate(fd, 0, _partition_size);
+    if (!e.is_error()) { e = me()->fsync(fd); }
+    W_COERCE(me()->close(fd));
+
+    if (e.is_error()) {
+        // Filesystem cannot pre-allocate; fall back to creating
+        // partition files on first append.
+        fs::remove(fpath);
+        _prealloc_partitions = false;
+    }
+}
+
 unsigned log_storage::delete_old_partitions(partition_number_t older_than)
 {
     if (!_delete_old_partitions) { return 0; }
@@ -419,6 +575,14 @@ unsigned log_storage::delete_old_partitions(partition_number_t older_than)
             else { it++; }
         }
 
+        if (!to_be_deleted.empty()) {
+            // invalidate the per-thread lookup caches in
+            // get_partition(); must happen before the unique() wait
+            // below so a reader that misses the bump is also
+            // guaranteed to hold its strong reference before our test
+            _reclaim_gen.fetch_add(1, std::memory_order_release);
+        }
+
         if (_checkpoints.size() > 1) {
             old_chkpts = _checkpoints;
             _checkpoints.clear();
@@ -468,6 +632,10 @@ fs::path log_storage::make_chkpt_path(lsn_t lsn) const
 {
     return _logpath / fs::path(chkpt_prefix + lsn.str());
 }
+fs::path log_storage::make_prealloc_path(partition_number_t pnum) const
+{
+    return _logpath / fs::path(prealloc_prefix + to_string(pnum));
+}
 
 void log_storage::try_delete(partition_number_t pnum)
 {
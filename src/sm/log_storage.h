@@ -64,6 +64,7 @@ Rome Research Laboratory Contract No. F30602-97-2-0247.
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
 
 typedef    smlevel_0::partition_number_t partition_number_t;
@@ -75,6 +76,7 @@ namespace fs = boost::filesystem;
 
 class skip_log;
 class partition_recycler_t;
+class partition_prealloc_t;
 
 class log_storage {
 
@@ -83,6 +85,7 @@ class log_storage {
     // use friend mechanism until better interface is implemented
     friend class partition_t;
     friend class partition_recycler_t;
+    friend class partition_prealloc_t;
 
 public:
     log_storage(const sm_options&);
@@ -102,8 +105,11 @@ public:
     string make_log_name(partition_number_t pnum) const;
     fs::path make_log_path(partition_number_t pnum) const;
     fs::path make_chkpt_path(lsn_t lsn) const;
+    fs::path make_prealloc_path(partition_number_t pnum) const;
 
     void wakeup_recycler();
+    void wakeup_preallocator();
+    void prealloc_next_partition();
     unsigned delete_old_partitions(partition_number_t older_than = 0);
 
 private:
@@ -121,6 +127,7 @@ private:
 
     unsigned _max_partitions;
     bool _delete_old_partitions;
+    bool _prealloc_partitions;
 
     // forbid copy
     log_storage(const log_storage&);
@@ -131,7 +138,14 @@ private:
     // Latch to protect access to partition map
     mutable mcs_rwlock _partition_map_latch;
 
+    // Bumped under the write latch whenever delete_old_partitions
+    // erases entries from the map; lets the per-thread lookup cache in
+    // get_partition() detect that a reclamation ran since it cached
+    // its entry (see the comments there).
+    std::atomic<unsigned> _reclaim_gen;
+
     unique_ptr<partition_recycler_t> _recycler_thread;
+    unique_ptr<partition_prealloc_t> _prealloc_thread;
 
 public:
     enum { BLOCK_SIZE = partition_t::XFERSIZE };
@@ -139,6 +153,8 @@ public:
     static const string log_regex;
     static const string chkpt_prefix;
     static const string chkpt_regex;
+    static const string prealloc_prefix;
+    static const string prealloc_regex;
 };
 
 #endif
@@ -1150,6 +1150,10 @@ LogArchiver::ArchiveScanner::open(PageID startPID, PageID endPID,
     // probe for runs
     archIndex->probe(probes, startPID, endPID, startLSN);
 
+    // fan-in is known now -- grow the merge heap once instead of
+    // doubling through it while the inputs are added
+    merger->reserveInputs(probes.size());
+
     // construct one run scanner for each probed run
     for (size_t i = 0; i < probes.size(); i++) {
         RunScanner* runScanner = new RunScanner(
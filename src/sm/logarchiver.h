@@ -600,6 +600,8 @@ public:
             virtual ~RunMerger() {}
 
             void addInput(RunScanner* r);
+            // pre-size the merge heap when the fan-in is known up front
+            void reserveInputs(size_t count) { heap.Reserve((int) count); }
             bool next(logrec_t*& lr);
             void dumpHeap(ostream& out);
             void close();
@@ -211,10 +211,19 @@ void logrec_t::redo(fixable_page_h* page)
     // operation to by-pass the page concurrent access check
 
 
+    // This generated switch is the specialization table: logdef.pl
+    // emits one case per record type, the concrete redo body inlines
+    // into its case, and the compiler lowers the dense type range to a
+    // single indirect jump. A hand-built function-pointer table would
+    // reproduce exactly this, minus the inlining.
     switch (header._type)  {
 #include "redo_gen.cpp"
     }
 
+    // Two plain 8-byte stores that cannot be fused: one lands in the
+    // frame's control block, the other in the page image itself --
+    // separate arrays, nowhere near one cache line. Neither involves a
+    // compare, so there is no branch to shave here either.
     page->update_page_lsn(lsn());
     page->set_img_page_lsn(lsn());
 }
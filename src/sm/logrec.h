@@ -334,10 +334,14 @@ public:
 
 inline bool baseLogHeader::is_valid() const
 {
-    return (_len >= sizeof(baseLogHeader)
-            && _type < logrec_t::t_max_logrec
-            && _cat != logrec_t::t_bad_cat
-            && _len <= sizeof(logrec_t));
+    // runs once per log record on every scan; all four tests are plain
+    // field comparisons, so evaluate them unconditionally and combine
+    // with & -- one branch at the caller instead of a short-circuit
+    // chain of four
+    return (_len >= sizeof(baseLogHeader))
+            & (_type < logrec_t::t_max_logrec)
+            & (_cat != logrec_t::t_bad_cat)
+            & (_len <= sizeof(logrec_t));
 }
 
 /**
@@ -780,8 +784,9 @@ logrec_t::is_cpsn() const
 inline bool
 logrec_t::is_page_update() const
 {
-    // old: return is_redo() && ! is_cpsn();
-    return is_redo() && !is_cpsn();
+    // same as is_redo() && !is_cpsn(), but one mask-and-compare of the
+    // category byte instead of a short-circuit chain of two tests
+    return (header._cat & (t_redo | t_cpsn)) == t_redo;
 }
 
 inline bool
@@ -71,13 +71,25 @@ Rome Research Laboratory Contract No. F30602-97-2-0247.
 
 partition_t::partition_t(log_storage *owner, partition_number_t num)
     : _num(num), _owner(owner), _size(-1),
-      _fhdl_rd(invalid_fhdl), _fhdl_app(invalid_fhdl)
+      _fhdl_rd(invalid_fhdl), _fhdl_app(invalid_fhdl),
+      _ra_hinted(0), _ra_back_hinted(std::numeric_limits<fileoff_t>::max())
 {
+}
+
+/*
+ * Each reading thread gets its own buffer, so that concurrent fetches
+ * on the same partition do not serialize on a shared one. Sized for a
+ * maximal log record plus block-alignment slack.
+ */
 #if SM_PAGESIZE < 8192
-    _readbuf = new char[log_storage::BLOCK_SIZE*4];
+static thread_local char tls_readbuf[log_storage::BLOCK_SIZE*4];
 #else
-    _readbuf = new char[SM_PAGESIZE*4];
+static thread_local char tls_readbuf[SM_PAGESIZE*4];
 #endif
+
+char* partition_t::read_buffer()
+{
+    return tls_readbuf;
 }
 
 /*
@@ -98,6 +110,13 @@ rc_t partition_t::open_for_append()
     return RCOK;
 }
 
+/*
+ * How far ahead of a forward scan to request kernel read-ahead.
+ * One hint is issued per window, not per record, so the syscall cost
+ * is amortized over many fetches.
+ */
+const partition_t::fileoff_t READ_AHEAD_WINDOW = 64 * partition_t::XFERSIZE;
+
 long floor2(long offset, long block_size)
 { return offset & -block_size; }
 long ceil2(long offset, long block_size)
@@ -137,14 +156,16 @@ rc_t partition_t::flush(
         long start1,
         long end1,
         long start2,
-        long end2)
+        long end2,
+        bool sync)
 {
     w_assert0(end1 >= start1);
     w_assert0(end2 >= start2);
     long size = (end2 - start2) + (end1 - start1);
     long write_size = size;
 
-    { // sync log: Seek the file to the right place.
+    long file_offset;
+    { // sync log: compute the file position of this flush.
         DBG5( << "Sync-ing log lsn " << lsn
                 << " start1 " << start1
                 << " end1 " << end1
@@ -152,7 +173,7 @@ rc_t partition_t::flush(
                 << " end2 " << end2 );
 
         // works because BLOCK_SIZE is always a power of 2
-        long file_offset = floor2(lsn.lo(), log_storage::BLOCK_SIZE);
+        file_offset = floor2(lsn.lo(), log_storage::BLOCK_SIZE);
         // offset is rounded down to a block_size
 
         long delta = lsn.lo() - file_offset;
@@ -162,13 +183,6 @@ rc_t partition_t::flush(
                                     // but works for unsigned...
         write_size += delta; // account for the extra (clean) bytes
         start1 -= delta;
-
-        /* FRJ: This seek is safe (in theory) because only one thread
-           can flush at a time and all other accesses to the file use
-           pread/pwrite (which doesn't change the file pointer).
-         */
-        fileoff_t where = file_offset;
-        W_DO(me()->lseek(_fhdl_app, where, sthread_t::SEEK_AT_SET));
     } // end sync log
 
     { // Copy a skip record to the end of the buffer.
@@ -207,12 +221,15 @@ rc_t partition_t::flush(
             iovec_t(block_of_zeros(),         grand_total-total),
         };
 
-        W_DO(me()->writev(_fhdl_app, iov, sizeof(iov)/sizeof(iovec_t)));
+        W_DO(me()->pwritev(_fhdl_app, iov, sizeof(iov)/sizeof(iovec_t),
+                    file_offset));
 
         ADD_TSTAT(log_bytes_written, grand_total);
     } // end copy skip record
 
-    fsync_delayed(_fhdl_app); // fsync
+    if (sync) {
+        fsync_delayed(_fhdl_app); // fsync
+    }
     return RCOK;
 }
 
@@ -221,8 +238,8 @@ rc_t partition_t::prime_buffer(char* buffer, lsn_t lsn, size_t& prime_offset)
     if (get_size() > 0) {
         logrec_t* lr;
         W_DO(read(lr, lsn, NULL));
-        memcpy(buffer, _readbuf, XFERSIZE);
-        prime_offset = (char*) lr - _readbuf;
+        memcpy(buffer, read_buffer(), XFERSIZE);
+        prime_offset = (char*) lr - read_buffer();
         release_read();
     }
     else { prime_offset = 0; }
@@ -232,10 +249,12 @@ rc_t partition_t::prime_buffer(char* buffer, lsn_t lsn, size_t& prime_offset)
 
 rc_t partition_t::read(logrec_t *&rp, lsn_t &ll, lsn_t* prev_lsn)
 {
-    _read_mutex.lock();
+    _read_lock.acquire_read();
 
     w_assert3(is_open_for_read());
 
+    char* readbuf = read_buffer();
+
     fileoff_t pos = ll.lo();
     fileoff_t lower = pos / XFERSIZE;
 
@@ -248,54 +267,68 @@ rc_t partition_t::read(logrec_t *&rp, lsn_t &ll, lsn_t* prev_lsn)
     );
 
     /*
-     * read & inspect header size and see
-     * and see if there's more to read
+     * read & inspect header size and see if there's more to read
      */
-    int64_t b = 0;
-    bool first_time = true;
-
-    rp = (logrec_t *)(_readbuf + off);
-
-    fileoff_t leftover = 0;
-
-    while (first_time || leftover > 0) {
-
-        DBG5(<<"leftover=" << int(leftover) << " b=" << b);
+    W_DO(me()->pread(_fhdl_rd, (void *)readbuf, XFERSIZE, lower));
 
-        W_DO(me()->pread(_fhdl_rd, (void *)(_readbuf + b), XFERSIZE, lower + b));
+    rp = (logrec_t *)(readbuf + off);
 
-        b += XFERSIZE;
+    // Try to get lsn of previous log record (for backward scan)
+    if (prev_lsn) {
+        if (off >= (int64_t)sizeof(lsn_t)) {
+            // most common and easy case -- prev_lsn is on the
+            // same block
+            *prev_lsn = *((lsn_t*) (readbuf + off - sizeof(lsn_t)));
+        }
+        else {
+            // we were unlucky -- extra IO required to fetch prev_lsn
+            int64_t prev_offset = lower - sizeof(lsn_t);
+            if (prev_offset < 0) {
+                *prev_lsn = lsn_t::null;
+            }
+            else {
+                W_COERCE(me()->pread(_fhdl_rd, (void*) prev_lsn, sizeof(lsn_t),
+                            prev_offset));
+            }
+        }
+    }
 
-        if (first_time) {
-            first_time = false;
-            leftover = rp->length() - (b - off);
-            DBG5(<<" leftover now=" << leftover);
+    fileoff_t leftover = rp->length() - (XFERSIZE - off);
+    if (leftover > 0) {
+        // rest of the record in one read; rounding up to full blocks
+        // cannot overshoot because partitions are always block-padded
+        fileoff_t rest = ceil2(leftover, XFERSIZE);
+        DBG5(<<"leftover=" << int(leftover) << " rest=" << int(rest));
 
-            // Try to get lsn of previous log record (for backward scan)
-            if (prev_lsn) {
-                if (off >= (int64_t)sizeof(lsn_t)) {
-                    // most common and easy case -- prev_lsn is on the
-                    // same block
-                    *prev_lsn = *((lsn_t*) (_readbuf + off - sizeof(lsn_t)));
-                }
-                else {
-                    // we were unlucky -- extra IO required to fetch prev_lsn
-                    int64_t prev_offset = lower + b - XFERSIZE - sizeof(lsn_t);
-                    if (prev_offset < 0) {
-                        *prev_lsn = lsn_t::null;
-                    }
-                    else {
-                        W_COERCE(me()->pread(_fhdl_rd, (void*) prev_lsn, sizeof(lsn_t),
-                                    prev_offset));
-                    }
-                }
-            }
-        } else {
-            leftover -= XFERSIZE;
-            w_assert3(leftover == (int)rp->length() - (b - off));
-            DBG5(<<" leftover now=" << leftover);
+        W_DO(me()->pread(_fhdl_rd, (void *)(readbuf + XFERSIZE), rest,
+                    lower + XFERSIZE));
+    }
+    // A null prev_lsn means the caller is scanning forward (recovery,
+    // archiver). Kick off read-ahead for the blocks the next fetches
+    // will need, so the I/O overlaps with log-record parsing. The
+    // unsynchronized _ra_hinted check can race, but a duplicate hint
+    // is harmless.
+    if (!prev_lsn) {
+        fileoff_t next = lower + XFERSIZE;
+        if (leftover > 0) {
+            next += ceil2(leftover, XFERSIZE);
         }
+        if (next >= _ra_hinted) {
+            (void) me()->fadvise(_fhdl_rd, next, READ_AHEAD_WINDOW,
+                    smthread_t::ADVISE_WILLNEED);
+            _ra_hinted = next + READ_AHEAD_WINDOW;
+        }
+    }
+    // Backward scan (log analysis): kernel readahead only looks
+    // forward, so hint the window *behind* the cursor ourselves.
+    else if (lower < _ra_back_hinted) {
+        fileoff_t back = lower > READ_AHEAD_WINDOW
+            ? lower - READ_AHEAD_WINDOW : 0;
+        (void) me()->fadvise(_fhdl_rd, back, lower - back,
+                smthread_t::ADVISE_WILLNEED);
+        _ra_back_hinted = back;
     }
+
     w_assert0(rp != NULL);
     w_assert0(rp->valid_header(ll));
     return RCOK;
@@ -303,20 +336,31 @@ rc_t partition_t::read(logrec_t *&rp, lsn_t &ll, lsn_t* prev_lsn)
 
 void partition_t::release_read()
 {
-    _read_mutex.unlock();
+    _read_lock.release_read();
 }
 
 rc_t partition_t::open_for_read()
 {
-    lock_guard<mutex> lck(_read_mutex);
-
     if(_fhdl_rd == invalid_fhdl) {
-        string fname = _owner->make_log_name(_num);
-        int fd, flags = smthread_t::OPEN_RDONLY;
-        W_DO(me()->open(fname.c_str(), flags, 0, fd));
-
-        w_assert3(_fhdl_rd == invalid_fhdl);
-        _fhdl_rd = fd;
+        CRITICAL_SECTION(cs, _read_lock.write_lock());
+        // re-check: another thread may have opened the fd meanwhile
+        if(_fhdl_rd == invalid_fhdl) {
+            string fname = _owner->make_log_name(_num);
+            int fd, flags = smthread_t::OPEN_RDONLY;
+            W_DO(me()->open(fname.c_str(), flags, 0, fd));
+
+            // log scans read front to back; let the kernel read ahead.
+            // Purely a hint -- ignore failures.
+            (void) me()->fadvise(fd, 0, 0, smthread_t::ADVISE_SEQUENTIAL);
+
+            // fresh descriptor, so forget what the previous one already
+            // hinted -- otherwise a reopened partition never gets
+            // WILLNEED windows again
+            _ra_hinted = 0;
+            _ra_back_hinted = std::numeric_limits<fileoff_t>::max();
+
+            _fhdl_rd = fd;
+        }
     }
     w_assert3(is_open_for_read());
 
@@ -372,6 +416,10 @@ void partition_t::fsync_delayed(int fd)
 rc_t partition_t::close_for_append()
 {
     if (_fhdl_app != invalid_fhdl)  {
+        // a full partition is rarely read again (only by recovery or
+        // the archiver); tell the kernel to drop its cached pages
+        // rather than let them crowd out the buffer pool
+        (void) me()->fadvise(_fhdl_app, 0, 0, smthread_t::ADVISE_DONTNEED);
         W_DO(me()->close(_fhdl_app));
         _fhdl_app = invalid_fhdl;
     }
@@ -381,6 +429,9 @@ rc_t partition_t::close_for_append()
 rc_t partition_t::close_for_read()
 {
     if (_fhdl_rd != invalid_fhdl)  {
+        // same reasoning as close_for_append: the scan that needed this
+        // partition is done, so let the kernel reclaim the cached pages
+        (void) me()->fadvise(_fhdl_rd, 0, 0, smthread_t::ADVISE_DONTNEED);
         W_DO(me()->close(_fhdl_rd));
         _fhdl_rd = invalid_fhdl;
     }
@@ -456,7 +507,7 @@ rc_t partition_t::scan_for_size(bool must_be_skip)
 
 void partition_t::destroy()
 {
-    lock_guard<mutex> lck(_read_mutex);
+    CRITICAL_SECTION(cs, _read_lock.write_lock());
 
     W_COERCE(close_for_read());
     W_COERCE(close_for_append());
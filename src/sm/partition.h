@@ -60,7 +60,6 @@ Rome Research Laboratory Contract No. F30602-97-2-0247.
 #include "w_defines.h"
 
 #include "logrec.h"
-#include <mutex>
 
 class log_storage; // forward
 
@@ -86,7 +85,11 @@ public:
     void release_read();
 
     rc_t flush(lsn_t lsn, const char* const buf, long start1, long end1,
-            long start2, long end2);
+            long start2, long end2, bool sync = true);
+
+    /** Sync the append fd.  Used by the flush daemon to issue one fsync
+     * for a batch of flush() calls that deferred their own (sync=false). */
+    void sync_append() { fsync_delayed(_fhdl_app); }
 
     bool is_open_for_read() const
     {
@@ -113,13 +116,21 @@ private:
     int                   _fhdl_rd;
     int                   _fhdl_app;
     static int            _artificial_flush_delay;  // in microseconds
-    char*                 _readbuf;
 
     void             fsync_delayed(int fd);
     rc_t scan_for_size(bool must_be_skip);
 
-    // Serialize read calls, which use the same buffer
-    mutex _read_mutex;
+    static char* read_buffer();
+
+    // end of the file range already hinted for read-ahead (see read())
+    fileoff_t _ra_hinted;
+
+    // start of the file range already hinted for a backward scan
+    fileoff_t _ra_back_hinted;
+
+    // Reads go through a per-thread buffer and only take the read side;
+    // the write side excludes destroy() and serializes the fd open
+    occ_rwlock _read_lock;
 };
 
 #endif
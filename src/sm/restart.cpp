@@ -60,7 +60,6 @@ Rome Research Laboratory Contract No. F30602-97-2-0247.
 #define RESTART_C
 
 #include "sm_base.h"
-#include "w_heap.h"
 #include "sm_base.h"
 #include "sm_base.h"
 #include "btree_impl.h"         // Lock re-acquisition
@@ -73,10 +72,13 @@ Rome Research Laboratory Contract No. F30602-97-2-0247.
 #include <fcntl.h>              // Performance reporting
 #include <unistd.h>
 #include <sstream>
+#include <algorithm>            // sort, for pid-ordered page redo
 
 restart_m::restart_m(const sm_options& options)
     : _restart_thread(NULL)
 {
+    int workers = options.get_int_option("sm_restart_redo_workers", 1);
+    _redo_workers = workers > 0 ? workers : 1;
 }
 
 restart_m::~restart_m()
@@ -126,6 +128,10 @@ void restart_m::log_analysis()
 
     //Re-add backups
     // CS TODO only works for one backup
+    // This is all that is left of the old per-device mount replay: the
+    // single volume is opened before recovery starts, so the one call
+    // below is the only device-level work on the critical path and
+    // there is nothing to batch or issue asynchronously here.
     smlevel_0::vol->sx_add_backup(chkpt.bkp_path, true);
 
     ADD_TSTAT(restart_log_analysis_time, timer.time_us());
@@ -134,7 +140,11 @@ void restart_m::log_analysis()
     ERROUT(<< "Log analysis found "
             << chkpt.buf_tab.size() << " dirty pages and "
             << chkpt.xct_tab.size() << " active transactions");
+#if W_DEBUG_LEVEL >= 3
+    // Full table dump is per-entry iostream work -- debug builds only;
+    // the one-line summary above suffices in production.
     chkpt.dump(cerr);
+#endif
 }
 
 /*********************************************************************
@@ -147,6 +157,39 @@ void restart_m::log_analysis()
  *  M1 only while system is not opened during the entire Recovery process
  *
  *********************************************************************/
+/*
+ * Worker for the parallel log-based REDO pass. Each worker replays one
+ * "slice" of the pages via its own scan of the whole log range; see
+ * _redo_log_slice for why the scan is replicated rather than split
+ * into disjoint LSN segments.
+ */
+class redo_log_worker_t : public smthread_t {
+public:
+    redo_log_worker_t(restart_m* restart, lsn_t redo_lsn, lsn_t end_lsn,
+            unsigned id, unsigned nworkers)
+        : smthread_t(t_regular, "redo_log_worker", WAIT_NOT_USED),
+          _restart(restart), _redo_lsn(redo_lsn), _end_lsn(end_lsn),
+          _id(id), _nworkers(nworkers), dirty_count(0)
+    {
+    }
+
+    virtual void run()
+    {
+        _restart->_redo_log_slice(_redo_lsn, _end_lsn, _id, _nworkers,
+                dirty_count);
+    }
+
+    uint32_t get_dirty_count() const { return dirty_count; }
+
+private:
+    restart_m* _restart;
+    lsn_t _redo_lsn;
+    lsn_t _end_lsn;
+    unsigned _id;
+    unsigned _nworkers;
+    uint32_t dirty_count;
+};
+
 void
 restart_m::redo_log_pass()
 {
@@ -158,27 +201,159 @@ restart_m::redo_log_pass()
     // How many pages have been changed from in_doubt to dirty?
     uint32_t dirty_count = 0;
 
+    if(redo_lsn < end_logscan_lsn) {
+        DBGOUT3(<< "Redoing log from " << redo_lsn
+                << " to " << end_logscan_lsn);
+        cerr << "Redoing log from " << redo_lsn
+            << " to " << end_logscan_lsn << endl;
+    }
+
+    if (_redo_workers > 1) {
+        vector<redo_log_worker_t*> workers;
+        for (unsigned i = 0; i < _redo_workers; i++) {
+            workers.push_back(new redo_log_worker_t(this, redo_lsn,
+                        end_logscan_lsn, i, _redo_workers));
+            W_COERCE(workers[i]->fork());
+        }
+        for (unsigned i = 0; i < _redo_workers; i++) {
+            W_COERCE(workers[i]->join());
+            dirty_count += workers[i]->get_dirty_count();
+            delete workers[i];
+        }
+    }
+    else {
+        _redo_log_slice(redo_lsn, end_logscan_lsn, 0, 1, dirty_count);
+    }
+
+    ADD_TSTAT(restart_redo_time, timer.time_us());
+    sysevent::log(logrec_t::t_redo_done);
+}
+
+/*
+ * Replay one worker's share of the log range [redo_lsn, end_logscan_lsn).
+ *
+ * REDO is only idempotent per page if each page sees its records in
+ * log order (the pageLSN test skips a record once a *newer* one has
+ * been applied), so disjoint LSN segments cannot be replayed
+ * concurrently without a per-page merge. Instead each worker scans the
+ * whole range and applies only the pages that hash to it -- scanning
+ * is cheap relative to fixing and replaying pages, especially with the
+ * preloaded fetch buffers. Records that touch no page (mount, backup,
+ * transaction-attached redo) are applied by worker 0 only.
+ *
+ * The alternative of one scanner feeding per-worker record queues was
+ * considered and rejected: every record would cross a core boundary
+ * (copy plus queue synchronization) just to save the other workers a
+ * sequential read of memory-resident log buffers, and multi-page
+ * records would need a draining fence between the two owners' queues.
+ * With replicated scans the two owners of a multi-page record each
+ * apply their half independently and in log order for free.
+ */
+void restart_m::_redo_log_slice(lsn_t redo_lsn, lsn_t end_logscan_lsn,
+        unsigned id, unsigned nworkers, uint32_t &dirty_count)
+{
     // Open a forward scan of the recovery log, starting from the redo_lsn which
     // is the earliest lsn determined in the Log Analysis phase
     DBGOUT3(<<"Start redo scanning at redo_lsn = " << redo_lsn);
     log_i scan(*smlevel_0::log, redo_lsn);
-    lsn_t cur_lsn = smlevel_0::log->curr_lsn();
-    if(redo_lsn < cur_lsn) {
-        DBGOUT3(<< "Redoing log from " << redo_lsn
-                << " to " << cur_lsn);
-        cerr << "Redoing log from " << redo_lsn
-            << " to " << cur_lsn << endl;
-    }
     DBGOUT3( << "LSN " << " A/R/I(pass): " << "LOGREC(TID, TYPE, FLAGS:F/U(fwd/rolling-back) PAGE <INFO>");
 
-    // Allocate a (temporary) log record buffer for reading
-    logrec_t r;
+    // Ring of log record buffers: the scan runs several records ahead
+    // of the dispatch, so the buffer-pool hash buckets the upcoming
+    // page lookups will probe are all prefetched while the current
+    // record is applied. Keeping multiple probes in flight lets the
+    // memory system overlap their DRAM misses instead of serializing
+    // one per record; a depth much beyond this risks the early lines
+    // being evicted again before their record is dispatched. The ring
+    // lives on the heap because logrec_t is sized for the largest
+    // record and eight of them would not fit on the stack comfortably.
+    static const size_t lookahead = 8;
+    logrec_t* recring = new logrec_t[lookahead];
+    lsn_t lsnring[lookahead];
+
+    // Compact per-slot view of the header fields the dispatch branches
+    // on, captured while the record is still hot from the scan copy.
+    // The ring slots are a full max-size record apart, so by the time
+    // a slot reaches the tail its header line may have left L1 again;
+    // the view keeps all eight slots' dispatch state in two lines.
+    struct recview_t {
+        PageID pid;
+        uint16_t type;      // logrec_t::kind_t
+        uint8_t is_redo;
+        uint8_t is_cpsn;
+    };
+    recview_t viewring[lookahead];
+
+    // Accumulate the dirty-page count locally and flush it once at the
+    // end of the scan: dirty_count refers into the worker's thread
+    // object, and bumping it per record would write that line (shared
+    // with the worker's other fields) millions of times for nothing.
+    uint32_t local_dirty_count = 0;
 
     lsn_t lsn;
+#if W_DEBUG_LEVEL > 0
+    // Only consumed by the continuity asserts below; in release the
+    // per-record advance() bookkeeping is dead work on the hot loop.
     lsn_t expected_lsn = redo_lsn;
+#endif
     bool redone = false;
-    while (scan.xct_next(lsn, r))
+
+    // Consecutive page-less records of the same transaction resolve to
+    // the same xct_t; remember the last probe so repeats cost one tid
+    // compare instead of a walk of the transaction list. Loser
+    // transactions are not removed from the table until the undo pass,
+    // so the cached pointer stays valid for the whole scan.
+    tid_t memo_tid = tid_t::null;
+    xct_t* memo_xd = NULL;
+
+    // The buffer pool pointer never changes during recovery, but the
+    // compiler cannot prove that across the opaque calls in the loop
+    // body and would reload the global once per record; pin it in a
+    // register here.
+    bf_tree_m* const bf = smlevel_0::bf;
+
+    // Last page this worker touched, held as a pin across records (see
+    // _redo_log_with_pid): WAL streams are bursty per page, so the
+    // repeat case skips the hashtable probe and refixes by slot index.
+    PageID cached_pid = 0;
+    bf_idx cached_idx = 0;
+
+    size_t head = 0;            // next ring slot to fill from the scan
+    size_t tail = 0;            // next ring slot to dispatch
+    bool scan_done = false;
+
+    while (true)
     {
+        // Top the ring up before dispatching: each record entering the
+        // ring hints the hashtable bucket its page lookup will probe,
+        // so by the time it reaches the tail the bucket line has had
+        // the whole ring's worth of redo work to arrive.
+        while (!scan_done && head - tail < lookahead) {
+            logrec_t& nr = recring[head % lookahead];
+            if (!scan.xct_next(lsnring[head % lookahead], nr)) {
+                scan_done = true;
+                break;
+            }
+            recview_t& nv = viewring[head % lookahead];
+            nv.pid = nr.pid();
+            nv.type = nr.type();
+            nv.is_redo = nr.is_redo();
+            nv.is_cpsn = nr.is_cpsn();
+            if (nv.is_redo && nv.pid != 0 && nv.pid % nworkers == id) {
+                bf->prefetch_lookup(nv.pid);
+                // and if the page is not resident yet, get the device
+                // read started before the record reaches the tail
+                bf->prefetch_page(nv.pid);
+            }
+            head++;
+        }
+        if (tail == head) { break; }
+
+        logrec_t& r = recring[tail % lookahead];
+        const recview_t& v = viewring[tail % lookahead];
+        lsn = lsnring[tail % lookahead];
+        tail++;
+
         if ((lsn > end_logscan_lsn))
         {
             // If concurrent recovery, user transactions would generate new log records
@@ -191,6 +366,9 @@ restart_m::redo_log_pass()
         DBGOUT3( << setiosflags(ios::right) << lsn
                 << resetiosflags(ios::right) << " R: " << r);
         w_assert1(lsn == r.lsn_ck());
+#if W_DEBUG_LEVEL > 0
+        // scan continuity check: each record must follow its
+        // predecessor, except across a partition boundary
         if (lsn == expected_lsn) {
             expected_lsn.advance(r.length());
         }
@@ -199,9 +377,15 @@ restart_m::redo_log_pass()
             expected_lsn = lsn;
             expected_lsn.advance(r.length());
         }
+#endif
 
-        if ( r.is_redo() )
+        if ( __builtin_expect(v.is_redo, 1) )
         {
+            // dispatch on the view fields captured at fill time rather
+            // than re-reading the record header
+            const logrec_t::kind_t type = (logrec_t::kind_t) v.type;
+            const PageID pid = v.pid;
+
             // If the log record is marked as REDOable (correct marking is important)
             // Most of the log records are REDOable.
             // These are not REDOable:
@@ -221,13 +405,26 @@ restart_m::redo_log_pass()
              * by checking if page id is 0 AND if it's not an operation that
              * would apply to the alloc_page, which can have pid 0.
              */
-            if (r.pid() == 0 && r.type() != logrec_t::t_alloc_page &&
-                    r.type() != logrec_t::t_dealloc_page)
+            // the overwhelming majority of redoable records carry a
+            // page; keep the page-less handling off the hot path
+            if (__builtin_expect(pid == 0 && type != logrec_t::t_alloc_page &&
+                    type != logrec_t::t_dealloc_page, 0))
             {
+                // page-less records are applied exactly once, by worker 0
+                if (id != 0) { continue; }
+
                 if (!r.is_single_sys_xct() && r.tid() != tid_t::null)
                 {
                     // Regular transaction with a valid txn id
-                    xct_t *xd = xct_t::look_up(r.tid());
+                    xct_t *xd;
+                    if (r.tid() == memo_tid) {
+                        xd = memo_xd;
+                    }
+                    else {
+                        xd = xct_t::look_up(r.tid());
+                        memo_tid = r.tid();
+                        memo_xd = xd;
+                    }
                     if (xd)
                     {
                         if (xd->state() == xct_t::xct_active)
@@ -254,17 +451,17 @@ restart_m::redo_log_pass()
                         // It must be a mount or dismount log record
 
                         w_assert3(
-                                r.type() == logrec_t::t_chkpt_backup_tab ||
-                                r.type() == logrec_t::t_add_backup);
+                                type == logrec_t::t_chkpt_backup_tab ||
+                                type == logrec_t::t_add_backup);
 
                         r.redo(0);
                     }
                     else
                     {
                         if ( // CS TODO -- restore not supported yet
-                                r.type() != logrec_t::t_restore_begin
-                                && r.type() != logrec_t::t_restore_segment
-                                && r.type() != logrec_t::t_restore_end
+                                type != logrec_t::t_restore_begin
+                                && type != logrec_t::t_restore_segment
+                                && type != logrec_t::t_restore_end
                            )
                         {
                             DBGOUT3(<<"redo - no page, ssx");
@@ -288,15 +485,24 @@ restart_m::redo_log_pass()
                 // achieve the 'transaction abort' effect during REDO phase, no UNDO for
                 // aborted transaction (aborted txn are not kept in transaction table).
 
-                _redo_log_with_pid(r, r.pid(), redone, dirty_count);
-                if (r.is_multi_page())
+                // each page belongs to exactly one worker, which sees
+                // all of the page's records in log order
+                if (pid % nworkers == id) {
+                    redone = _redo_log_with_pid(r, pid,
+                            cached_pid, cached_idx);
+                    local_dirty_count += redone ? 1 : 0;
+                }
+                if (r.is_multi_page() && r.pid2() % nworkers == id)
                 {
                     w_assert1(r.is_single_sys_xct());
-                    _redo_log_with_pid(r, r.pid2(), redone, dirty_count);
+                    bool redone2 = _redo_log_with_pid(r, r.pid2(),
+                            cached_pid, cached_idx);
+                    local_dirty_count += redone2 ? 1 : 0;
+                    redone = redone || redone2;
                 }
             }
         }
-        else if ( r.is_cpsn() )
+        else if ( v.is_cpsn )
         {
             // Compensate log record in recovery log, they are from aborted/rollback transaction
             // before system crash, these transactions have been rollbacked before the system crash.
@@ -322,32 +528,84 @@ restart_m::redo_log_pass()
 
     }
 
-    ADD_TSTAT(restart_redo_time, timer.time_us());
-    sysevent::log(logrec_t::t_redo_done);
+    // drop the last-page pin before the worker goes away
+    if (cached_idx != 0) {
+        bf->unpin_for_refix(cached_idx);
+    }
+
+    delete[] recring;
+    dirty_count += local_dirty_count;
 }
 
 /*********************************************************************
 *
-*  restart_m::_redo_log_with_pid(r, lsn,end_logscan_lsn, page_updated, redone, dirty_count)
+*  restart_m::_redo_log_with_pid(r, page_updated)
 *
 *  For each log record, load the physical page if it is not in buffer pool yet, set the flags
 *  and apply the REDO based on log record if the page is old
 *
-*  Function returns void, if encounter error condition (any error), raise error and abort
-*  the operation, it cannot continue
+*  Returns whether REDO was applied; the caller accumulates its dirty
+*  count locally from that, so no counter reference is threaded through
+*  the per-record calls. If encounter error condition (any error),
+*  raise error and abort the operation, it cannot continue
 *
 *********************************************************************/
-void restart_m::_redo_log_with_pid(logrec_t& r, PageID pid,
-        bool &redone, uint32_t &dirty_count)
+bool restart_m::_redo_log_with_pid(logrec_t& r, PageID pid,
+        PageID& cached_pid, bf_idx& cached_idx)
 {
-    redone = false;             // True if REDO happened
-    w_assert1(r.is_redo());
-
-    bool virgin_page = r.type() == logrec_t::t_page_img_format
-            || (r.type() == logrec_t::t_btree_split && pid == r.pid());
-
+    bool redone = false;        // True if REDO happened
+    // Per-record invariant checks in this function are level 2: they
+    // run once per log record on the REDO critical path, and each one
+    // is a handful of loads and compares that level 1 ("should not add
+    // significant extra time") cannot afford at redo rates. The caller
+    // already guarantees is_redo() by dispatching on the captured view.
+    w_assert2(r.is_redo());
+
+    // Evaluated with bitwise ops rather than short-circuiting: the
+    // record type varies unpredictably from call to call, so the
+    // cascaded form costs a misprediction per type change, while three
+    // compares on registers already in hand are effectively free.
+    const logrec_t::kind_t type = r.type();
+    const bool virgin_page = (type == logrec_t::t_page_img_format)
+            | ((type == logrec_t::t_btree_split) & (pid == r.pid()));
+
+    // Latches are acquired try-then-defer: the conditional fix maps to
+    // the rwlock's single-CAS attempt path, which suffices because
+    // each page belongs to exactly one redo worker -- only a
+    // concurrent on-demand fix can make it fail, and then the retry
+    // joins the queue exactly as an unconditional acquire would have.
+    //
+    // The handle itself is deliberately a fresh stack object per call:
+    // its constructor writes three fields, and its destructor is the
+    // latch release, which must happen per record anyway so concurrent
+    // on-demand fixes are never blocked across records. What is worth
+    // carrying between calls -- the frame residency -- is carried by
+    // the pin below, not by a long-lived handle.
     fixable_page_h page;
-    W_COERCE(page.fix_direct(pid, LATCH_EX, false, virgin_page));
+    if (pid == cached_pid && !virgin_page) {
+        // same page as the previous record of this worker: the pin
+        // held in cached_idx kept the frame resident, so refix by slot
+        // index and skip the hashtable probe entirely
+        if (__builtin_expect(
+                page.refix_direct(cached_idx, LATCH_EX, true).is_error(), 0)) {
+            W_COERCE(page.refix_direct(cached_idx, LATCH_EX, false));
+        }
+    }
+    else {
+        if (__builtin_expect(
+                page.fix_direct(pid, LATCH_EX, true, virgin_page).is_error(), 0)) {
+            W_COERCE(page.fix_direct(pid, LATCH_EX, false, virgin_page));
+        }
+
+        // retarget the worker's pin to this page while the latch is
+        // still held; the pin (not the latch) is what survives across
+        // records and blocks eviction of the cached frame
+        if (cached_idx != 0) {
+            smlevel_0::bf->unpin_for_refix(cached_idx);
+        }
+        cached_idx = page.pin_for_refix();
+        cached_pid = pid;
+    }
 
     if (virgin_page) {
         page.get_generic_page()->pid = pid;
@@ -358,36 +616,135 @@ void restart_m::_redo_log_with_pid(logrec_t& r, PageID pid,
 
     if (page_lsn < r.lsn())
     {
-        w_assert1(pid == r.pid() || pid == r.pid2());
-        w_assert1(pid != r.pid() || (r.page_prev_lsn() == lsn_t::null ||
+        w_assert2(pid == r.pid() || pid == r.pid2());
+        w_assert2(pid != r.pid() || (r.page_prev_lsn() == lsn_t::null ||
             r.page_prev_lsn() == page_lsn));
 
-        w_assert1(pid != r.pid2() || (r.page2_prev_lsn() == lsn_t::null ||
+        w_assert2(pid != r.pid2() || (r.page2_prev_lsn() == lsn_t::null ||
             r.page2_prev_lsn() == page_lsn));
 
-        w_assert1(page.is_fixed());
+        w_assert2(page.is_fixed());
         r.redo(&page);
         redone = true;
-        ++dirty_count;
     }
+
+    return redone;
 }
 
+/*
+ * Worker for the parallel page-driven REDO pass. Pages are recovered
+ * independently by single-page recovery (fixing the page replays its
+ * page-log chain), so worker i simply restores every entry of the
+ * dirty-page table whose position is congruent to i modulo the worker
+ * count -- no cross-worker ordering is required.
+ */
+class redo_worker_t : public smthread_t {
+public:
+    typedef vector<pair<PageID, lsn_t> > entry_list_t;
+
+    redo_worker_t(const entry_list_t* entries, unsigned id, unsigned nworkers)
+        : smthread_t(t_regular, "redo_worker", WAIT_NOT_USED),
+          _entries(entries), _id(id), _nworkers(nworkers)
+    {
+    }
+
+    virtual void run()
+    {
+        generic_page* page;
+        // the buffer manager pointer is loaded once: smlevel_0::bf is
+        // a mutable global the compiler must otherwise re-read after
+        // every opaque call in the loop
+        bf_tree_m* const bf = smlevel_0::bf;
+        const size_t size = _entries->size();
+        // entries are sorted by pid and the workers take interleaved
+        // positions, so all workers sweep the volume in ascending
+        // order together instead of each seeking randomly
+        for (size_t i = _id; i < size; i += _nworkers)
+        {
+            // warm the hashtable bucket of this worker's next page
+            // while the current fix is busy with disk and log replay;
+            // the device read itself was already hinted by the ranged
+            // pre-pass in redo_page_pass
+            if (i + _nworkers < size) {
+                bf->prefetch_lookup((*_entries)[i + _nworkers].first);
+            }
+            // simply fixing the page will take care of single-page recovery
+            W_COERCE(bf->fix_nonroot(page, NULL, (*_entries)[i].first,
+                        LATCH_SH, false, false, (*_entries)[i].second));
+            bf->unfix(page);
+        }
+    }
+
+private:
+    const entry_list_t* _entries;
+    unsigned _id;
+    unsigned _nworkers;
+};
+
 void restart_m::redo_page_pass()
 {
     generic_page* page;
     stopwatch_t timer;
 
-    buf_tab_t::const_iterator iter = chkpt.buf_tab.begin();
-    while (iter != chkpt.buf_tab.end()) {
-        PageID pid = iter->first;
-        lsn_t lastLSN = iter->second.page_lsn;
+    // Restore in ascending pid order rather than buf_tab's hash order:
+    // iterating the unordered_map directly turns the page reads into
+    // random seeks over the volume, while sorted order fetches the
+    // pages of an extent together and hands the kernel's read-ahead
+    // sequential runs to work with.
+    // Recovering many pages writes into that many untouched frames;
+    // pre-fault them in one kernel call instead of one minor fault per
+    // first write.
+    if (!chkpt.buf_tab.empty()) {
+        smlevel_0::bf->prefault_frames();
+    }
 
-        // simply fixing the page will take care of single-page recovery
-        W_COERCE(smlevel_0::bf->fix_nonroot(
-                    page, NULL, pid, LATCH_SH, false, false, lastLSN));
-        smlevel_0::bf->unfix(page);
+    redo_worker_t::entry_list_t entries;
+    entries.reserve(chkpt.buf_tab.size());
+    for (buf_tab_t::const_iterator it = chkpt.buf_tab.begin();
+            it != chkpt.buf_tab.end(); ++it)
+    {
+        entries.push_back(make_pair(it->first, it->second.page_lsn));
+    }
+    std::sort(entries.begin(), entries.end());
+
+    // With the list sorted, adjacent dirty pages show up as runs of
+    // consecutive pids. Hand each run to the kernel as one ranged
+    // read-ahead hint before any worker starts fixing: a single large
+    // read then replaces the per-page reads that fix_nonroot would
+    // otherwise issue one by one, and the workers find the images
+    // already in the page cache.
+    for (size_t i = 0; i < entries.size(); ) {
+        size_t j = i + 1;
+        while (j < entries.size()
+                && entries[j].first == entries[j - 1].first + 1) {
+            j++;
+        }
+        smlevel_0::vol->prefetch_pages(entries[i].first, j - i);
+        i = j;
+    }
 
-        iter++;
+    if (_redo_workers > 1 && entries.size() > 1) {
+        vector<redo_worker_t*> workers;
+        for (unsigned i = 0; i < _redo_workers; i++) {
+            workers.push_back(new redo_worker_t(&entries, i, _redo_workers));
+            W_COERCE(workers[i]->fork());
+        }
+        for (unsigned i = 0; i < _redo_workers; i++) {
+            W_COERCE(workers[i]->join());
+            delete workers[i];
+        }
+    }
+    else {
+        bf_tree_m* const bf = smlevel_0::bf;
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (i + 1 < entries.size()) {
+                bf->prefetch_lookup(entries[i + 1].first);
+            }
+            // simply fixing the page will take care of single-page recovery
+            W_COERCE(bf->fix_nonroot(page, NULL, entries[i].first,
+                        LATCH_SH, false, false, entries[i].second));
+            bf->unfix(page);
+        }
     }
 
     ADD_TSTAT(restart_redo_time, timer.time_us());
@@ -404,9 +761,8 @@ void restart_m::undo_pass()
         return;
     }
 
-    w_ostrstream s;
-    s << "restart concurrent undo_txn_pass";
-    (void) log_comment(s.c_str());
+    // constant marker string -- no need to format it through w_ostrstream
+    (void) log_comment("restart concurrent undo_txn_pass");
 
     // Loop through the transaction table and look for loser txn
     // Do not lock the transaction table when looping through entries
@@ -421,12 +777,29 @@ void restart_m::undo_pass()
     // undo the loser transactions in the reverse order, which is the
     // order of execution we need
 
+    // Walking the table here is not the O(all transactions) filter it
+    // looks like: log analysis only instantiates xct_t objects for
+    // in-flight (loser) transactions, so at this point the list *is*
+    // the doomed set, plus whatever new user transactions arrived in
+    // mixed mode -- and those are exactly what the latch-and-state
+    // checks below are for. A separate doomed vector from analysis
+    // would go stale the moment a concurrent on-demand rollback
+    // retires one of its entries.
     xct_i iter(false); // not locking the transaction table list
     xct_t* xd = 0;
     xct_t* curr = 0;
     xd = iter.next();
     while (xd)
     {
+        // The transaction list is a pointer chase through nodes that
+        // have been cold since log analysis built them. Touch the
+        // successor now so its cache miss overlaps with the latch,
+        // abort and destroy work on the current node instead of
+        // stalling the next iteration's first access.
+        if (xct_t* succ = iter.peek_next()) {
+            __builtin_prefetch(succ, 0, 1);
+        }
+
         DBGOUT3( << "Transaction " << xd->tid()
                  << " has state " << xd->state() );
 
@@ -460,6 +833,12 @@ void restart_m::undo_pass()
             continue;
         }
 
+        // The loser flags stay inside xct_t rather than in an external
+        // bitmap: they are only ever read together with the state and
+        // latch of the same object (one cache line that is being
+        // touched anyway), and the transient transaction table has no
+        // stable slot numbering for a bitmap to index. The dense-bitmap
+        // treatment pays off for per-frame buffer-pool state, not here.
         if ((xct_t::xct_active == xd->state()) && (true == xd->is_loser_xct())
              && (false == xd->is_loser_xct_in_undo()))
         {
@@ -523,7 +902,12 @@ void restart_m::undo_pass()
                     me()->attach_xct(curr);
                     W_COERCE( curr->abort() );
 
-                    // Then destroy the loser transaction
+                    // Then destroy the loser transaction. One at a
+                    // time on purpose: delete goes straight back to
+                    // the thread-local slab and is noise next to the
+                    // abort() above, while deferring the unlink would
+                    // widen the window in which concurrent on-demand
+                    // undo can observe a half-retired transaction.
                     delete curr;
                 }
             }
@@ -549,11 +933,39 @@ void restart_m::undo_pass()
     // All loser transactions have been taken care of now
     // Force a recovery log flush, this would harden the log records
     // generated by compensation operations
+    //
+    // This is the only blocking flush of the pass: each abort() above
+    // writes its compensation and end records with a non-blocking
+    // _sync_logbuf (unchained restart losers never hit the synchronous
+    // prepared/chained case), so the pass group-commits -- N aborts,
+    // one fsync here.
 
     W_COERCE( smlevel_0::log->flush_all() );
     sysevent::log(logrec_t::t_undo_done);
 }
 
+/*
+ * Runs the UNDO pass on its own thread so it can overlap with page-
+ * driven REDO. The overlap is safe for the same reason concurrent user
+ * transactions are: any page UNDO fixes before the REDO pass reaches it
+ * is brought to its current state on demand by single-page recovery
+ * inside the fix, and when the REDO pass arrives later it finds the
+ * page already recovered and does nothing. Total background recovery
+ * time thus approaches max(REDO, UNDO) instead of their sum.
+ */
+class undo_thread_t : public smthread_t {
+public:
+    undo_thread_t()
+        : smthread_t(t_regular, "undo_thread", WAIT_NOT_USED)
+    {
+    }
+
+    virtual void run()
+    {
+        smlevel_0::recovery->undo_pass();
+    }
+};
+
 //*********************************************************************
 // Main body of the child thread restart_thread_t for Recovery process
 // Only used if system is in concurrent recovery mode, while the system was
@@ -563,8 +975,18 @@ void restart_thread_t::run()
 {
     // CS TODO: add mechanism to interrupt restart thread and terminate
     // before recovery is complete
+    undo_thread_t undo_thread;
+    W_COERCE(undo_thread.fork());
     smlevel_0::recovery->redo_page_pass();
-    smlevel_0::recovery->undo_pass();
+    W_COERCE(undo_thread.join());
     smlevel_0::log->discard_fetch_buffers();
+    smlevel_0::vol->discard_dirty_pages();
+
+    // Background recovery is complete -- bound a future re-recovery the
+    // same way the offline path does, unless the start was clean.
+    chkpt_t* chkpt_info = smlevel_0::recovery->get_chkpt();
+    if (!chkpt_info->buf_tab.empty() || !chkpt_info->xct_tab.empty()) {
+        smlevel_0::chkpt->take();
+    }
 };
 
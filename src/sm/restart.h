@@ -35,11 +35,11 @@
 #define RESTART_H
 
 #include "w_defines.h"
-#include "w_heap.h"
 
 #include "sm_base.h"
 #include "chkpt.h"
 #include "lock.h"               // Lock re-acquisition
+#include "bf_hashtable.h"       // bf_idx, for the redo last-page cache
 
 #include <map>
 
@@ -76,6 +76,7 @@ private:
 class restart_m
 {
     friend class restart_thread_t;
+    friend class redo_log_worker_t;
 
 public:
     restart_m(const sm_options&);
@@ -109,6 +110,11 @@ private:
 
     bool instantRestart;
 
+    // Number of threads restoring dirty pages in redo_page_pass.
+    // Pages are independent under single-page recovery, so the pass
+    // parallelizes across distinct page IDs (sm_restart_redo_workers).
+    unsigned _redo_workers;
+
     // Child thread, used only if open system after Log Analysis phase while REDO and UNDO
     // will be performed with concurrent user transactions
     restart_thread_t*           _restart_thread;
@@ -181,12 +187,27 @@ public:
 
 private:
     // Function used for serialized operations, open system after the entire restart process finished
+    // One worker's share of the log-based REDO pass: scans the whole
+    // range but applies only pages with pid % nworkers == id (worker 0
+    // also applies page-less records). See the definition for why the
+    // scan is replicated instead of split into LSN segments.
+    void _redo_log_slice(lsn_t redo_lsn, lsn_t end_logscan_lsn,
+            unsigned id, unsigned nworkers, uint32_t &dirty_count);
+
     // brief sub-routine of redo_pass() for logs that have pid.
-    void                 _redo_log_with_pid(
+    // Returns whether REDO was actually applied, so the caller can
+    // accumulate its dirty count in a local instead of threading a
+    // reference-carried counter through every call.
+    // cached_pid/cached_idx carry the worker's last-touched page as a
+    // pin held across calls (see pin_for_refix()): consecutive records
+    // against the same page refix by slot index and skip the hashtable
+    // probe inside fix_direct. The caller owns the pin and must
+    // release it with unpin_for_refix() when its scan ends.
+    bool                 _redo_log_with_pid(
                                 logrec_t& r,                   // In: Incoming log record
                                 PageID page_updated,
-                                bool &redone,                  // Out: did REDO occurred?  Validation purpose
-                                uint32_t &dirty_count);        // Out: dirty page count, validation purpose
+                                PageID& cached_pid,            // In/out: pid of pinned page
+                                bf_idx& cached_idx);           // In/out: slot of pinned page
 };
 
 #endif
@@ -358,6 +358,18 @@ ss_m::_construct_once()
 
         log->discard_fetch_buffers();
 
+        // ARIES only requires the log to be durable at this point --
+        // REDO is idempotent -- so there is no need to force the
+        // recovered pages synchronously. A checkpoint bounds what a
+        // re-recovery would have to rescan, and the cleaner flushes
+        // the dirty pages in the background while the system serves
+        // transactions. On a clean start there is nothing to bound:
+        // skip the checkpoint and its log fsync altogether.
+        if (!chkpt_info->buf_tab.empty() || !chkpt_info->xct_tab.empty()) {
+            chkpt->take();
+            bf->get_cleaner()->wakeup(false);
+        }
+
         // CS: added this for debugging, but consistency check fails
         // even right after loading -- so it's not a recovery problem
         // vector<StoreID> stores;
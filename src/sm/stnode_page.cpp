@@ -9,6 +9,7 @@
 #include "eventlog.h"
 
 stnode_cache_t::stnode_cache_t(bool create)
+    : _min_unused_hint(1)
 {
     int res= posix_memalign((void**) &_stnode_page, sizeof(generic_page),
             sizeof(generic_page));
@@ -28,22 +29,6 @@ stnode_cache_t::stnode_cache_t(bool create)
     }
 }
 
-PageID stnode_cache_t::get_root_pid(StoreID store) const
-{
-    w_assert1(store < stnode_page::max);
-
-    // CRITICAL_SECTION (cs, _spin_lock);
-    // Commented out to improve scalability, as this is called for
-    // EVERY operation.  NOTE this protection is not needed because
-    // this is unsafe only when there is a concurrent DROP INDEX (or
-    // DROP TABLE).  It should be protected by intent locks (if it's
-    // no-lock mode... it's user's responsibility).
-    //
-    // JIRA: ZERO-168 notes that DROP INDEX/TABLE currently are not
-    // implemented and to fix this routine once they are.
-    return _stnode_page.get(store).root;
-}
-
 stnode_t stnode_cache_t::get_stnode(StoreID store) const
 {
     return _stnode_page.get(store);
@@ -51,7 +36,11 @@ stnode_t stnode_cache_t::get_stnode(StoreID store) const
 
 bool stnode_cache_t::is_allocated(StoreID store) const
 {
-    CRITICAL_SECTION (cs, _latch);
+    // Latch-free for the same reason as get_root_pid: the stnode is a
+    // single aligned 32-bit word, so this reads either zero or the
+    // complete root pid. A caller that needs the answer to stay true
+    // across its own operation must hold the appropriate intent lock,
+    // which is what screens out concurrent destroys (see above).
     return get_stnode(store).is_used();
 }
 
@@ -61,8 +50,13 @@ StoreID stnode_cache_t::get_min_unused_stid() const
 
     // Let's start from 1, not 0.  All user store ID's will begin with 1.
     // Store-ID 0 will be a special store-ID for stnode_page/alloc_page's
-    for (size_t i = 1; i < stnode_page::max; ++i) {
+    //
+    // Resume from the hint: ids below it are known used, and since
+    // stores are never deleted an unused id stays unused, so skipping
+    // the used prefix once per call keeps allocation amortized O(1).
+    for (size_t i = _min_unused_hint; i < stnode_page::max; ++i) {
         if (!_stnode_page.get(i).is_used()) {
+            _min_unused_hint = i;
             return i;
         }
     }
@@ -114,6 +114,8 @@ public:
     /**
      * Returns the root page ID of the given store.
      * If that store isn't allocated, returns 0.
+     * Defined below in this header: this is called for EVERY operation
+     * and boils down to two loads, so it must inline at the callers.
      * @param[in] store Store ID.
      */
     PageID get_root_pid(StoreID store) const;
@@ -155,6 +157,15 @@ private:
     /// Required to maintain per-page log chain (see comments on alloc_cache.h)
     lsn_t prev_page_lsn;
 
+    /**
+     * Scan start for get_min_unused_stid(): no store id below this is
+     * unused. Stores are never deleted (see ZERO-168), so the minimum
+     * unused id only grows and the hint never has to move backwards;
+     * each scan resumes where the last one stopped, making allocation
+     * amortized O(1) instead of O(max) per store.
+     */
+    mutable StoreID _min_unused_hint;
+
     /// Returns the first StoreID that can be used for a new store in
     /// this volume or stnode_page::max if all available stores of
     /// this volume are already allocated.
@@ -162,4 +173,25 @@ private:
 
 };
 
+inline PageID stnode_cache_t::get_root_pid(StoreID store) const
+{
+    w_assert1(store < stnode_page::max);
+
+    // CRITICAL_SECTION (cs, _spin_lock);
+    // Commented out to improve scalability, as this is called for
+    // EVERY operation.  NOTE this protection is not needed because
+    // this is unsafe only when there is a concurrent DROP INDEX (or
+    // DROP TABLE).  It should be protected by intent locks (if it's
+    // no-lock mode... it's user's responsibility).
+    //
+    // JIRA: ZERO-168 notes that DROP INDEX/TABLE currently are not
+    // implemented and to fix this routine once they are.
+    //
+    // The latch-free read cannot tear either: stnode_t is a single
+    // aligned 32-bit word, so a concurrent sx_create_store publishes
+    // the root pid with one store and readers see either 0 or the
+    // complete value -- no seqlock needed around it.
+    return _stnode_page.get(store).root;
+}
+
 #endif // STNODE_PAGE_H
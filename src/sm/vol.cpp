@@ -35,7 +35,8 @@ vol_t::vol_t(const sm_options& options, chkpt_t* chkpt_info)
                _fake_disk_latency(0),
                _alloc_cache(NULL), _stnode_cache(NULL),
                _failed(false),
-               _restore_mgr(NULL), _dirty_pages(NULL), _backup_fd(-1),
+               _restore_mgr(NULL), _dirty_pages(NULL),
+               _dirty_pages_discarded(false), _backup_fd(-1),
                _current_backup_lsn(lsn_t::null), _backup_write_fd(-1),
                _log_page_reads(false)
 {
@@ -77,6 +78,10 @@ vol_t::~vol_t()
     if (_restore_mgr) {
         delete _restore_mgr;
     }
+    if (_dirty_pages) {
+        delete _dirty_pages;
+        _dirty_pages = NULL;
+    }
 }
 
 rc_t vol_t::sync()
@@ -97,7 +102,12 @@ void vol_t::build_caches(bool truncate)
 
 lsn_t vol_t::get_dirty_page_emlsn(PageID pid) const
 {
-    if (!_dirty_pages) { return lsn_t::null; }
+    // Unsynchronized fast path: the flag only ever goes false->true,
+    // and a stale read merely costs one latched probe of the (by then
+    // empty) table.
+    if (!_dirty_pages || *&_dirty_pages_discarded) { return lsn_t::null; }
+
+    spinlock_read_critical_section cs(&_mutex);
 
     buf_tab_t::const_iterator it = _dirty_pages->find(pid);
     if (it == _dirty_pages->end()) { return lsn_t::null; }
@@ -106,7 +116,7 @@ lsn_t vol_t::get_dirty_page_emlsn(PageID pid) const
 
 void vol_t::delete_dirty_page(PageID pid)
 {
-    if (!_dirty_pages) { return; }
+    if (!_dirty_pages || *&_dirty_pages_discarded) { return; }
 
     spinlock_write_critical_section cs(&_mutex);
 
@@ -116,6 +126,23 @@ void vol_t::delete_dirty_page(PageID pid)
     }
 }
 
+void vol_t::discard_dirty_pages()
+{
+    if (!_dirty_pages) { return; }
+
+    spinlock_write_critical_section cs(&_mutex);
+
+    // Once restart has recovered every dirty page, the table only
+    // answers "no".  Empty it (under the latch, since instant-restart
+    // readers may be probing it right now) but keep it alive for the
+    // volume's lifetime -- deleting it would pull the table out from
+    // under a reader that passed the null check.  Future reads take
+    // the discarded fast path in get_dirty_page_emlsn instead of a
+    // hash probe.
+    _dirty_pages->clear();
+    _dirty_pages_discarded = true;
+}
+
 rc_t vol_t::open_backup()
 {
     // mutex held by caller -- no concurrent backup being added
@@ -465,6 +492,24 @@ rc_t vol_t::read_page(PageID pnum, generic_page* const buf)
     return read_many_pages(pnum, buf, 1);
 }
 
+void vol_t::prefetch_page(PageID pnum)
+{
+    // Same offset math as read_many_pages; the hint lets the kernel
+    // start the device read while the caller is still busy elsewhere,
+    // so the eventual pread completes from the page cache. A failed
+    // hint only loses the overlap, hence the ignored return.
+    size_t offset = size_t(pnum) * sizeof(generic_page);
+    (void) me()->fadvise(_unix_fd, offset, sizeof(generic_page),
+            smthread_t::ADVISE_WILLNEED);
+}
+
+void vol_t::prefetch_pages(PageID pnum, size_t count)
+{
+    size_t offset = size_t(pnum) * sizeof(generic_page);
+    (void) me()->fadvise(_unix_fd, offset, count * sizeof(generic_page),
+            smthread_t::ADVISE_WILLNEED);
+}
+
 rc_t vol_t::read_page_verify(PageID pnum, generic_page* const buf, lsn_t emlsn)
 {
     W_DO(read_many_pages(pnum, buf, 1));
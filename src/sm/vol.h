@@ -53,6 +53,19 @@ public:
 
     rc_t read_page(PageID page, generic_page* const buf);
 
+    /**
+     * Hint the OS to start reading a page image ahead of an expected
+     * read_page(). Purely a cache hint; errors are swallowed.
+     */
+    void prefetch_page(PageID page);
+
+    /**
+     * Ranged form of prefetch_page(): one hint covering count
+     * consecutive pages starting at page, so the kernel can issue a
+     * single large read instead of count small ones.
+     */
+    void prefetch_pages(PageID page, size_t count);
+
     /**
      * Read page and verify if it is either corrupted or out-of-date according
      * to the given EMLSN (expected minimum LSN). If that's the case, invoke
@@ -143,6 +156,13 @@ public:
 
     bool caches_ready() { return _alloc_cache && _stnode_cache; }
 
+    /** Empty the dirty page table once restart has recovered every page
+     * in it, so that subsequent reads take the discarded fast path instead
+     * of probing a table that can only answer "no".  The table itself stays
+     * alive until the volume is destroyed, since instant-restart readers
+     * may still be probing it concurrently. */
+    void discard_dirty_pages();
+
 private:
     // variables read from volume header -- remain constant after mount
     int              _unix_fd;
@@ -175,10 +195,15 @@ private:
     std::vector<string> _backups;
     std::vector<lsn_t> _backup_lsns;
 
-    /** Dirty pages that require REDO after restart **/
-    // CS TODO: this should be destroyed once recovery is complete
+    /** Dirty pages that require REDO after restart; emptied by
+     * discard_dirty_pages() once recovery is complete, freed only in
+     * the destructor **/
     buf_tab_t* _dirty_pages;
 
+    /** Set once discard_dirty_pages() has emptied the table; lets
+     * get_dirty_page_emlsn answer "clean" without taking _mutex **/
+    bool _dirty_pages_discarded;
+
     /** Currently opened backup (during restore only) */
     int _backup_fd;
     lsn_t _current_backup_lsn;
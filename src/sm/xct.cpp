@@ -295,8 +295,12 @@ xct_t::xct_t(sm_stats_info_t* stats, timeout_in_ms timeout, bool sys_xct,
 #endif
 {
     w_assert3(state() == xct_active);
-    if (given_tid != tid_t::null) {
-        // tid is given if transaction is being built during restart
+    if (given_tid != tid_t::null && !loser_xct) {
+        // tid is given if transaction is being built during restart.
+        // Losers are exempt: log analysis raises _nxt_tid to the
+        // highest tid it saw (update_youngest_tid) before recreating
+        // any of them, so the per-transaction CAS loop here would be
+        // a no-op RMW on a shared counter for every recovered xct.
         _nxt_tid.atomic_assign_max(given_tid);
     }
 
@@ -542,15 +546,18 @@ xct_t::cleanup(bool /*dispose_prepared*/)
  *  Return the number of active transactions (equivalent to the
  *  size of _xlist.
  *
+ *  The count is read without acquiring the xlist mutex: a snapshot
+ *  taken under the mutex would be just as stale by the time the
+ *  caller looks at it, since transactions keep coming and going.
+ *  All callers (empty checks, shutdown assertions, statistics) only
+ *  need such a snapshot; anyone who needs the list to hold still
+ *  must hold the mutex across the whole operation anyway.
+ *
  *********************************************************************/
 uint32_t
 xct_t::num_active_xcts()
 {
-    uint32_t num;
-    W_COERCE(acquire_xlist_mutex());
-    num = _xlist.num_members();
-    release_xlist_mutex();
-    return  num;
+    return _xlist.num_members();
 }
 
 
@@ -561,6 +568,15 @@ xct_t::num_active_xcts()
  *
  *  Find the record for tid and return it. If not found, return 0.
  *
+ *  The table behind this is an intrusive list kept in descending tid
+ *  order, not a hash or tree: lookups by tid are rare (recovery
+ *  memoizes its last hit, and normal operation reaches transactions
+ *  through the attached thread), while ordered iteration -- the
+ *  checkpoint scan, undo, oldest-tid queries -- is constant. An
+ *  indexed structure would tax every transaction create/destroy to
+ *  speed up a cold probe; the early termination below already bounds
+ *  the walk.
+ *
  *********************************************************************/
 xct_t*
 xct_t::look_up(const tid_t& tid)
@@ -572,6 +588,12 @@ xct_t::look_up(const tid_t& tid)
         if (xd->tid() == tid) {
             return xd;
         }
+        // _xlist is keyed in descending tid order, so once the scan
+        // passes the target the tid cannot appear further down -- stop
+        // instead of walking (and cache-missing) the rest of the list
+        if (xd->tid() < tid) {
+            return 0;
+        }
     }
     return 0;
 }
@@ -1013,6 +1013,8 @@ public:
     xct_t* curr() const { return unsafe_iterator.curr(); }
     /// Advance cursor.
     xct_t* next() { return unsafe_iterator.next(); }
+    /// Look at the transaction after the cursor without advancing.
+    xct_t* peek_next() const { return unsafe_iterator.peek_next(); }
 
     /**\cond skip */
     // Note that this is called to INIT the attribute "locked"
@@ -1,4 +1,5 @@
 #include <sstream>
+#include <random>
 #include "sm.h"
 #include "stopwatch.h"
 #include "sm_options.h"
@@ -1,3 +1,6 @@
+#include <sstream>
+#include <fstream>
+
 #define private public
 
 #include "btree_test_env.h"